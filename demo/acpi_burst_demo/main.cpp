@@ -0,0 +1,59 @@
+#include "pfs/acpi/burst_sampler.hpp"
+#include <algorithm>
+#include <iostream>
+#include <cstdlib>
+
+// Usage: acpi_burst_demo RATE_HZ DURATION_MS ATTRIBUTE_PATH...
+// e.g. acpi_burst_demo 1000 500 /sys/class/powercap/intel-rapl:0/energy_uj /sys/class/thermal/thermal_zone0/temp
+int main (int argc, char * argv[])
+{
+    if (argc < 4) {
+        std::cerr << "Usage: " << argv[0] << " RATE_HZ DURATION_MS ATTRIBUTE_PATH...\n";
+        return -1;
+    }
+
+    double rate = atof(argv[1]);
+    int duration = atoi(argv[2]);
+
+    if (!(rate > 0) || rate > pfs::burst_sampler::MAX_RATE) {
+        std::cerr << "Rate must be in range (0, " << pfs::burst_sampler::MAX_RATE << "] Hz\n";
+        return -1;
+    }
+
+    if (duration <= 0) {
+        std::cerr << "Duration must be positive\n";
+        return -1;
+    }
+
+    pfs::burst_sampler sampler;
+
+    for (int i = 3; i < argc; i++) {
+        if (sampler.add_attribute(argv[i]) < 0) {
+            std::cerr << "Failed to open attribute: " << argv[i] << "\n";
+            return -1;
+        }
+    }
+
+    // Sampling stops when buffer is full
+    double const max_samples = 1000000;
+    sampler.reserve(static_cast<size_t>(std::min(rate * duration / 1000, max_samples)) + 1);
+
+    auto stats = sampler.run(rate, duration);
+
+    std::cout << "Requested rate: " << stats.requested_rate << " Hz\n";
+    std::cout << "Achieved rate : " << stats.achieved_rate << " Hz\n";
+    std::cout << "Samples       : " << stats.samples << "\n";
+    std::cout << "Max interval  : " << stats.max_interval_ns / 1000 << " us\n";
+    std::cout << "Read errors   : " << stats.read_errors << "\n";
+
+    for (size_t i = 0; i < sampler.samples_count() && i < 10; i++) {
+        std::cout << sampler.timestamp_at(i);
+
+        for (int j = 0; j < sampler.attributes_count(); j++)
+            std::cout << "\t" << sampler.value_at(i, j);
+
+        std::cout << "\n";
+    }
+
+    return 0;
+}
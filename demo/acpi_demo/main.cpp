@@ -1,7 +1,81 @@
 #include "pfs/acpi.hpp"
+#include <cstdlib>
+#include <cstring>
 #include <iostream>
 
-int main ()
+#if defined(__linux__)
+#   include "pfs/acpi/read_latency.hpp"
+#   include <cstdio>
+
+// Usage: acpi_demo [--latency [CYCLES]]
+//
+// With `--latency` refreshes devices CYCLES times (100 by default) and dumps
+// histograms of attribute read latencies per device class and per attribute.
+
+static void print_summary (char const * name, pfs::latency_histogram const & h)
+{
+    printf("%-48s %8llu %9.1f %9.1f %9.1f %9.1f %9.1f\n", name
+        , static_cast<unsigned long long>(h.count)
+        , h.mean_ns() / 1000.0
+        , h.percentile(50) / 1000.0
+        , h.percentile(99) / 1000.0
+        , h.percentile(99.9) / 1000.0
+        , h.max_ns / 1000.0);
+}
+
+static void print_buckets (pfs::latency_histogram const & h)
+{
+    for (int i = 0; i < pfs::latency_histogram::BUCKETS; i++) {
+        if (h.counts[i] == 0)
+            continue;
+
+        printf("    %12.3f .. %12.3f us: %8llu %5.1f%%\n"
+            , pfs::latency_histogram::bucket_lower(i) / 1000.0
+            , (pfs::latency_histogram::bucket_upper(i) + 1) / 1000.0
+            , static_cast<unsigned long long>(h.counts[i])
+            , 100.0 * h.counts[i] / h.count);
+    }
+}
+
+static void dump_latencies (pfs::acpi & acpi, int cycles)
+{
+    for (int i = 0; i < cycles; i++)
+        acpi.refresh();
+
+    struct {
+        char const * name;
+        int devices;
+    } const classes[] = {
+          {"battery", pfs::acpi::dev_battery}
+        , {"ac_adapter", pfs::acpi::dev_ac_adapter}
+        , {"ups", pfs::acpi::dev_ups}
+        , {"usb_power_supply", pfs::acpi::dev_usb_power_supply}
+        , {"thermal_zone", pfs::acpi::dev_thermal_zone}
+        , {"fan", pfs::acpi::dev_fan}
+    };
+
+    printf("\nRead latencies after %d refresh cycles (us):\n", cycles);
+    printf("%-48s %8s %9s %9s %9s %9s %9s\n", "", "reads", "mean", "p50", "p99", "p99.9", "max");
+
+    for (auto const & c: classes) {
+        auto h = pfs::read_latency::snapshot(c.devices);
+
+        if (h.count > 0) {
+            print_summary(c.name, h);
+            print_buckets(h);
+        }
+    }
+
+    printf("\n");
+
+    for (auto const & a: pfs::read_latency::snapshot()) {
+        if (a.histogram.count > 0)
+            print_summary(a.path.c_str(), a.histogram);
+    }
+}
+#endif
+
+int main (int argc, char * argv[])
 {
     if (!pfs::acpi::has_acpi_support()) {
         std::cerr << "It's seems No ACPI support for your system!\n";
@@ -10,10 +84,29 @@ int main ()
 
     std::cout << "This system has ACPI support!\n";
 
+#if defined(__linux__)
+    int latency_cycles = 0;
+
+    if (argc > 1 && std::strcmp(argv[1], "--latency") == 0) {
+        latency_cycles = argc > 2 ? std::atoi(argv[2]) : 100;
+        pfs::read_latency::enable();
+    }
+#else
+    (void)argc;
+    (void)argv;
+#endif
+
     pfs::acpi acpi;
     acpi.acquire();
 
     acpi.dump(std::cout, true);
 
+#if defined(__linux__)
+    if (latency_cycles > 0) {
+        std::cout.flush();
+        dump_latencies(acpi, latency_cycles);
+    }
+#endif
+
     return 0;
 }
@@ -0,0 +1,32 @@
+#include "pfs/acpi/devices.hpp"
+#include <iostream>
+
+int main ()
+{
+    pfs::acpi_devices devices;
+    devices.discover();
+
+    std::cout << "ACPI devices available: " << devices.devices_available() << "\n";
+
+    for (int i = 0; i < devices.devices_available(); i++) {
+        auto dev = devices.device_at(i);
+        std::cout << dev.name
+            << "\thid: " << dev.hid
+            << "\tpath: " << dev.path
+            << "\tstatus: " << dev.status
+            << "\tpower state: " << to_string(dev.power_state)
+            << " (real: " << to_string(dev.real_power_state) << ")\n";
+    }
+
+    devices.refresh();
+
+    auto d0_devices = devices.find_by_power_state(pfs::power_state_enum::d0);
+    std::cout << "Devices in D0 state: " << d0_devices.size() << "\n";
+
+    for (auto index: d0_devices) {
+        auto dev = devices.device_at(index);
+        std::cout << "\t" << dev.name << " " << dev.path << "\n";
+    }
+
+    return 0;
+}
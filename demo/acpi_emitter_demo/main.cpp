@@ -0,0 +1,180 @@
+#include "pfs/acpi/metrics_emitter.hpp"
+#include "../fake_sysfs.hpp"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+// Sends readings to metrics collector. Without `--port` the collector is
+// stood in by local UDP socket and readings are taken from fake sysfs tree:
+// received datagrams are printed and checked against the tree content.
+//
+// Usage: acpi_emitter_demo [--statsd] [--host HOST] [--port PORT]
+//          [--tags TAGS] [--mtu SIZE] [-i INTERVAL_MS] [-n COUNT]
+// Lines (or their beginnings) expected from fake sysfs tree
+static std::vector<std::string> expected_lines (pfs::emitter_options const & options)
+{
+    auto const & p = options.prefix;
+
+    if (options.format == pfs::emitter_options::format_statsd) {
+        return std::vector<std::string> {
+              p + ".battery.BAT0.percentage:50|g\n"
+            , p + ".battery.BAT0.seconds:7200|g\n"
+            , p + ".ac_adapter.AC.online:0|g\n"
+            , p + ".thermal_zone.thermal_zone0.temperature:45|g\n"
+            , p + ".fan.cooling_device0.cur_state:1|g\n"
+            , p + ".fan.cooling_device0.max_state:1|g\n"
+        };
+    }
+
+    auto tags = options.tags.empty() ? std::string{} : "," + options.tags;
+
+    return std::vector<std::string> {
+          "\n" + p + "_battery,device=BAT0" + tags + " percentage=50i,seconds=7200i,rate=1000i,charge_state=2i "
+        , "\n" + p + "_ac_adapter,device=AC" + tags + " online=0i "
+        , "\n" + p + "_thermal_zone,device=thermal_zone0" + tags + " temperature=45 "
+        , "\n" + p + "_fan,device=cooling_device0" + tags + " cur_state=1i,max_state=1i "
+    };
+}
+
+int main (int argc, char * argv[])
+{
+    pfs::emitter_options options;
+    int interval_ms = 1000;
+    int count = 3;
+    bool standin = true;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--statsd") == 0) {
+            options.format = pfs::emitter_options::format_statsd;
+        } else if (strcmp(argv[i], "--host") == 0 && i + 1 < argc) {
+            options.host = argv[++i];
+        } else if (strcmp(argv[i], "--port") == 0 && i + 1 < argc) {
+            options.port = atoi(argv[++i]);
+            standin = false;
+        } else if (strcmp(argv[i], "--tags") == 0 && i + 1 < argc) {
+            options.tags = argv[++i];
+        } else if (strcmp(argv[i], "--mtu") == 0 && i + 1 < argc) {
+            options.max_datagram_size = static_cast<size_t>(atol(argv[++i]));
+        } else if (strcmp(argv[i], "-i") == 0 && i + 1 < argc) {
+            interval_ms = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "-n") == 0 && i + 1 < argc) {
+            count = atoi(argv[++i]);
+        } else {
+            fprintf(stderr, "Usage: %s [--statsd] [--host HOST] [--port PORT]"
+                " [--tags TAGS] [--mtu SIZE] [-i INTERVAL_MS] [-n COUNT]\n", argv[0]);
+            return -1;
+        }
+    }
+
+    int collector = -1;
+
+    if (standin) {
+        collector = socket(AF_INET, SOCK_DGRAM, 0);
+
+        struct sockaddr_in addr;
+        std::memset(& addr, 0, sizeof(addr));
+        addr.sin_family = AF_INET;
+        addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        socklen_t len = sizeof(addr);
+
+        if (collector < 0 || bind(collector, reinterpret_cast<sockaddr *>(& addr), len) != 0
+                || getsockname(collector, reinterpret_cast<sockaddr *>(& addr), & len) != 0) {
+            fprintf(stderr, "Failed to create collector stand-in socket\n");
+            return -1;
+        }
+
+        options.host = "127.0.0.1";
+        options.port = ntohs(addr.sin_port);
+    }
+
+    pfs::metrics_emitter emitter;
+
+    if (!emitter.open(options)) {
+        fprintf(stderr, "Failed to open emitter: %s:%d\n", options.host.c_str(), options.port);
+        return -1;
+    }
+
+    fake_sysfs::tree t;
+
+    if (standin && (!t.ok() || !fake_sysfs::populate_power_supply(t)
+            || !fake_sysfs::populate_thermal(t) || !fake_sysfs::populate_cooling_device(t))) {
+        fprintf(stderr, "Failed to create fake sysfs tree\n");
+        return -1;
+    }
+
+    pfs::acpi acpi {standin ? t.root() : std::string{"/sys"}};
+    acpi.acquire(pfs::acpi::dev_all);
+
+    size_t received = 0;
+    std::string content;
+
+    for (int i = 0; i < count; i++) {
+        if (i > 0) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(interval_ms));
+            acpi.refresh(pfs::acpi::dev_all);
+        }
+
+        auto records = emitter.emit(acpi);
+
+        if (records < 0)
+            fprintf(stderr, "Failed to send records\n");
+
+        if (standin) {
+            char buf[65536];
+            ssize_t n;
+
+            while ((n = recv(collector, buf, sizeof(buf), MSG_DONTWAIT)) > 0) {
+                printf("--- datagram of %zd bytes\n%.*s", n, static_cast<int>(n), buf);
+                content += '\n'; // datagram starts new line
+                content.append(buf, static_cast<size_t>(n));
+                ++received;
+            }
+        }
+    }
+
+    auto stats = emitter.stats();
+
+    printf("Records      : %llu\n", static_cast<unsigned long long>(stats.records));
+    printf("Datagrams    : %llu\n", static_cast<unsigned long long>(stats.datagrams));
+    printf("Bytes        : %llu\n", static_cast<unsigned long long>(stats.bytes));
+    printf("Send calls   : %llu\n", static_cast<unsigned long long>(stats.send_calls));
+    printf("Errors       : %llu\n", static_cast<unsigned long long>(stats.errors));
+
+    if (standin) {
+        close(collector);
+
+        if (received != stats.datagrams) {
+            fprintf(stderr, "Received %zu datagrams of %llu sent\n", received
+                , static_cast<unsigned long long>(stats.datagrams));
+            return 1;
+        }
+
+        int missing = 0;
+
+        for (auto const & line: expected_lines(options)) {
+            // Each emit sends the same readings
+            size_t found = 0;
+
+            for (auto pos = content.find(line); pos != std::string::npos; pos = content.find(line, pos + 1))
+                ++found;
+
+            if (found != static_cast<size_t>(count)) {
+                fprintf(stderr, "Expected %d times, received %zu: %s\n", count, found, line.c_str());
+                ++missing;
+            }
+        }
+
+        if (missing > 0)
+            return 1;
+    }
+
+    return 0;
+}
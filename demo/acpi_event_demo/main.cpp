@@ -0,0 +1,43 @@
+#include "pfs/acpi/event.hpp"
+#include <iostream>
+#include <poll.h>
+
+int main ()
+{
+    pfs::acpi_event_listener listener;
+
+    if (!listener.open()) {
+        std::cerr << "Failed to subscribe to ACPI events\n";
+        return -1;
+    }
+
+    pfs::acpi acpi;
+    acpi.acquire();
+
+    std::cout << "Waiting for ACPI events (Ctrl+C to exit)\n";
+
+    struct pollfd pfd;
+    pfd.fd = listener.native_handle();
+    pfd.events = POLLIN;
+
+    while (::poll(& pfd, 1, -1) > 0) {
+        std::vector<pfs::acpi_event> events;
+
+        if (listener.receive(events) < 0) {
+            acpi.acquire();
+            continue;
+        }
+
+        for (auto const & ev: events) {
+            std::cout << ev.device_class << " " << ev.bus_id
+                << " type: " << std::hex << ev.type
+                << " data: " << ev.data << std::dec << "\n";
+
+            pfs::acpi_event_listener::apply(ev, acpi);
+        }
+
+        acpi.dump(std::cout);
+    }
+
+    return 0;
+}
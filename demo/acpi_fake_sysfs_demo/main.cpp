@@ -0,0 +1,326 @@
+#include "pfs/acpi.hpp"
+#include "pfs/acpi/epp.hpp"
+#include "pfs/acpi/event.hpp"
+#include "pfs/acpi/platform_profile.hpp"
+#include "pfs/acpi/powercap.hpp"
+#include "../fake_sysfs.hpp"
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <linux/genetlink.h>
+#include <linux/netlink.h>
+
+// Checks library behaviour on fake sysfs tree laid out like the kernel's.
+// Exits with non-zero status if any check fails.
+//
+// Usage: acpi_fake_sysfs_demo
+
+static int g_failures = 0;
+
+static void check (bool condition, char const * what)
+{
+    printf("%-60s %s\n", what, condition ? "OK" : "FAILED");
+
+    if (!condition)
+        ++g_failures;
+}
+
+static void check_platform_profile (fake_sysfs::tree const & t)
+{
+    pfs::platform_profile pp {t.root()};
+
+    check(pp.is_supported(), "platform_profile: supported");
+    check(pp.current() == "performance", "platform_profile: current profile read");
+    check(pp.set("quiet"), "platform_profile: switched to shorter profile");
+
+    // Library writes value as is, without truncating the attribute
+    auto written = t.read("firmware/acpi/platform_profile");
+    check(written.compare(0, 5, "quiet") == 0, "platform_profile: value written");
+
+    t.commit_write("firmware/acpi/platform_profile", 5);
+    pp.refresh();
+    check(pp.current() == "quiet", "platform_profile: value re-read");
+}
+
+static void check_cpu_epp (fake_sysfs::tree const & t)
+{
+    std::string const cpu0 = "devices/system/cpu/cpu0/cpufreq/energy_performance_preference";
+    std::string const cpu1 = "devices/system/cpu/cpu1/cpufreq/energy_performance_preference";
+
+    pfs::cpu_epp epp {t.root()};
+    epp.discover();
+
+    check(epp.cpus_available() == 2, "cpu_epp: CPUs discovered");
+
+    if (epp.cpus_available() != 2)
+        return;
+
+    std::vector<pfs::cpu_epp::code_type> codes;
+    epp.read(codes);
+    check(codes[0] == epp.code_of("balance_performance") && codes[1] == -1
+        , "cpu_epp: numeric value has no preference code");
+
+    {
+        pfs::scoped_cpu_epp guard {epp, "power"};
+
+        check(guard.is_active(), "cpu_epp: preference overridden");
+        check(t.read(cpu0).compare(0, 5, "power") == 0 && t.read(cpu1).compare(0, 5, "power") == 0
+            , "cpu_epp: preference written to all CPUs");
+
+        t.commit_write(cpu0, 5);
+        t.commit_write(cpu1, 5);
+    }
+
+    t.commit_write(cpu1, 3);
+    check(t.read(cpu0) == "balance_performance", "cpu_epp: preference restored");
+    check(t.read(cpu1) == "128", "cpu_epp: numeric value restored");
+
+    // Changed by other tool after the last read: cached value is stale
+    t.write(cpu0, "power\n");
+    check(epp.apply("balance_performance") == 2 && t.read(cpu0) == "balance_performance"
+        , "cpu_epp: value changed behind the scenes is overwritten");
+}
+
+// Mirrors `struct acpi_genl_event` from drivers/acpi/event.c
+struct genl_event_payload
+{
+    char device_class[20];
+    char bus_id[15];
+    std::uint32_t type;
+    std::uint32_t data;
+};
+
+// Appends netlink message carrying ACPI event as the kernel multicasts it
+static void append_event_message (std::vector<char> & buf, int family_id, int cmd
+    , char const * device_class, char const * bus_id, std::uint32_t type, std::uint32_t data)
+{
+    genl_event_payload payload;
+    std::memset(& payload, 0, sizeof(payload));
+    std::strncpy(payload.device_class, device_class, sizeof(payload.device_class) - 1);
+    std::strncpy(payload.bus_id, bus_id, sizeof(payload.bus_id) - 1);
+    payload.type = type;
+    payload.data = data;
+
+    auto offset = buf.size();
+    auto len = NLMSG_LENGTH(GENL_HDRLEN + NLA_HDRLEN + sizeof(payload));
+    buf.resize(offset + NLMSG_ALIGN(len), 0);
+
+    auto nh = reinterpret_cast<struct nlmsghdr *>(& buf[offset]);
+    nh->nlmsg_len = len;
+    nh->nlmsg_type = static_cast<std::uint16_t>(family_id);
+
+    auto genl = static_cast<struct genlmsghdr *>(NLMSG_DATA(nh));
+    genl->cmd = static_cast<std::uint8_t>(cmd);
+    genl->version = 1;
+
+    auto nla = reinterpret_cast<struct nlattr *>(reinterpret_cast<char *>(genl) + GENL_HDRLEN);
+    nla->nla_len = static_cast<std::uint16_t>(NLA_HDRLEN + sizeof(payload));
+    nla->nla_type = 1; // ACPI_GENL_ATTR_EVENT
+    std::memcpy(reinterpret_cast<char *>(nla) + NLA_HDRLEN, & payload, sizeof(payload));
+}
+
+static int battery_percentage (pfs::acpi const & acpi, char const * name)
+{
+    for (size_t i = 0; i < acpi.batteries_available(); i++) {
+        auto bat = acpi.battery_at(static_cast<int>(i));
+
+        if (std::string(bat.name.data(), bat.name.size()) == name)
+            return bat.percentage;
+    }
+
+    return -1;
+}
+
+static float zone_temperature (pfs::acpi const & acpi, char const * name)
+{
+    for (size_t i = 0; i < acpi.thermal_zones_available(); i++) {
+        auto tz = acpi.thermal_zone_at(static_cast<int>(i));
+
+        if (std::string(tz.name.data(), tz.name.size()) == name)
+            return tz.temperature;
+    }
+
+    return -1;
+}
+
+static void check_events ()
+{
+    int const family_id = 30;
+    int const cmd_event = 1;
+
+    fake_sysfs::tree t;
+
+    if (!t.ok() || !fake_sysfs::populate_power_supply(t) || !fake_sysfs::populate_thermal(t)
+            || !t.write("class/power_supply/BAT1/type", "Battery\n")
+            || !t.write("class/power_supply/BAT1/status", "Discharging\n")
+            || !t.write("class/power_supply/BAT1/charge_now", "1000000\n")
+            || !t.write("class/power_supply/BAT1/charge_full", "4000000\n")
+            || !t.write("class/thermal/thermal_zone1/temp", "50000\n")
+            || !fake_sysfs::bind_acpi_device(t, "class/power_supply/BAT0", "PNP0C0A:00")
+            || !fake_sysfs::bind_acpi_device(t, "class/power_supply/BAT1", "PNP0C0A:01")
+            || !fake_sysfs::bind_acpi_device(t, "class/power_supply/AC", "ACPI0003:00")
+            || !fake_sysfs::bind_acpi_device(t, "class/thermal/thermal_zone0", "LNXTHERM:00")
+            || !fake_sysfs::bind_acpi_device(t, "class/thermal/thermal_zone1", "LNXTHERM:01")) {
+        check(false, "acpi_event: fake sysfs tree created");
+        return;
+    }
+
+    std::vector<char> buf;
+    append_event_message(buf, family_id, cmd_event, "battery", "PNP0C0A:01", 0x80, 1);
+    append_event_message(buf, family_id + 1, cmd_event, "battery", "PNP0C0A:00", 0x80, 1);
+    append_event_message(buf, family_id, cmd_event + 1, "battery", "PNP0C0A:00", 0x80, 1);
+    append_event_message(buf, family_id, cmd_event, "ac_adapter", "ACPI0003:00", 0x80, 1);
+    append_event_message(buf, family_id, cmd_event, "thermal_zone", "LNXTHERM:00", 0x81, 0);
+    append_event_message(buf, family_id, cmd_event, "button/power", "PNP0C0C:00", 0x80, 1);
+
+    std::vector<pfs::acpi_event> events;
+    auto count = pfs::acpi_event_listener::parse(buf.data(), buf.size(), family_id, events);
+
+    check(count == 4 && events.size() == 4, "acpi_event: foreign family and command skipped");
+
+    if (events.size() != 4)
+        return;
+
+    check(events[0].device_class == "battery" && events[0].bus_id == "PNP0C0A:01"
+        && events[0].type == 0x80 && events[0].data == 1, "acpi_event: event fields parsed");
+    check(pfs::acpi_event_listener::parse(buf.data(), NLMSG_HDRLEN + 2, family_id, events) == 0
+        , "acpi_event: truncated message skipped");
+    check(pfs::acpi_event_listener::affected_devices(events[0]) == pfs::acpi::dev_battery
+        && pfs::acpi_event_listener::affected_devices(events[1]) == pfs::acpi::dev_ac_adapter
+        && pfs::acpi_event_listener::affected_devices(events[2]) == pfs::acpi::dev_thermal_zone
+        && pfs::acpi_event_listener::affected_devices(events[3]) == pfs::acpi::dev_none
+        , "acpi_event: affected devices");
+
+    pfs::acpi acpi {t.root()};
+    acpi.acquire();
+
+    t.write("class/power_supply/BAT0/charge_now", "3000000\n");
+    t.write("class/power_supply/BAT1/charge_now", "3000000\n");
+    t.write("class/power_supply/AC/online", "1\n");
+    t.write("class/thermal/thermal_zone0/temp", "60000\n");
+    t.write("class/thermal/thermal_zone1/temp", "60000\n");
+
+    pfs::acpi_event_listener::apply(events[0], acpi);
+    check(battery_percentage(acpi, "BAT1") == 75 && battery_percentage(acpi, "BAT0") == 50
+        , "acpi_event: only targeted battery refreshed");
+    check(acpi.ac_adapters_available() == 1 && acpi.ac_adapter_at(0).state == pfs::ac_state_enum::offline
+        , "acpi_event: AC adapter untouched by battery event");
+
+    pfs::acpi_event_listener::apply(events[1], acpi);
+    check(acpi.ac_adapter_at(0).state == pfs::ac_state_enum::online
+        , "acpi_event: AC adapter refreshed");
+
+    pfs::acpi_event_listener::apply(events[2], acpi);
+    check(zone_temperature(acpi, "thermal_zone0") == 60 && zone_temperature(acpi, "thermal_zone1") == 50
+        , "acpi_event: only targeted thermal zone refreshed");
+
+    pfs::acpi_event_listener::apply(events[3], acpi);
+    check(battery_percentage(acpi, "BAT0") == 50 && zone_temperature(acpi, "thermal_zone1") == 50
+        , "acpi_event: unrelated event refreshes nothing");
+}
+
+static void check_scoped_power_limit (fake_sysfs::tree const & t)
+{
+    pfs::powercap pc {t.root()};
+    pc.discover();
+
+    check(pc.domains_available() == 1, "powercap: domain discovered");
+
+    if (pc.domains_available() != 1)
+        return;
+
+    t.write("class/powercap/intel-rapl:0/energy_uj", "3000000\n");
+
+    {
+        pfs::scoped_power_limit limit {pc, 0, 0, 20000000};
+
+        check(limit.is_active(), "powercap: limit overridden");
+        check(pc.domain_at(0).energy_uj == 1000000, "powercap: override keeps energy counter");
+        check(t.read("class/powercap/intel-rapl:0/constraint_0_power_limit_uw") == "20000000\n"
+            , "powercap: limit written");
+    }
+
+    check(t.read("class/powercap/intel-rapl:0/constraint_0_power_limit_uw") == "15000000\n"
+        , "powercap: limit restored");
+
+    pc.refresh();
+    check(pc.domain_at(0).energy_uj == 3000000 && pc.domain_at(0).power_uw > 0
+        , "powercap: power measured against previous refresh");
+}
+
+static void check_cooling_stats (fake_sysfs::tree const & t, pfs::acpi & acpi)
+{
+    auto stats = acpi.cooling_stats_at(0);
+    check(stats.total_trans == 3, "cooling_stats: total transitions");
+    check(stats.time_in_state_ms.size() == 2, "cooling_stats: states");
+
+    t.write("class/thermal/cooling_device0/stats/total_trans", "5\n");
+    t.write("class/thermal/cooling_device0/stats/time_in_state_ms", "state0 150\nstate1 230\n");
+    acpi.refresh(pfs::acpi::dev_fan);
+
+    stats = acpi.cooling_stats_at(0);
+    check(stats.trans_delta == 2, "cooling_stats: transitions delta tracks refresh");
+    check(stats.time_in_state_delta_ms.size() == 2
+        && stats.time_in_state_delta_ms[0] == 50
+        && stats.time_in_state_delta_ms[1] == 30, "cooling_stats: time in state delta tracks refresh");
+
+    acpi.refresh(pfs::acpi::dev_fan);
+    stats = acpi.cooling_stats_at(0);
+    check(stats.trans_delta == 0 && stats.time_in_state_delta_ms[0] == 0
+        , "cooling_stats: no changes since previous refresh");
+}
+
+static void check_fan (pfs::acpi const & acpi)
+{
+    auto fan = acpi.fan_at(0);
+    check(fan.performance_states.size() == 2, "fan: performance states read via firmware_node");
+    check(fan.rpm == 1900, "fan: speed read via firmware_node");
+    check(fan.power == 1500, "fan: power of current state");
+}
+
+int main ()
+{
+    fake_sysfs::tree t;
+
+    if (!t.ok() || !fake_sysfs::populate_power_supply(t) || !fake_sysfs::populate_thermal(t)
+            || !fake_sysfs::populate_cooling_device(t) || !fake_sysfs::populate_platform_profile(t)
+            || !fake_sysfs::populate_powercap(t) || !fake_sysfs::populate_cpu_epp(t)) {
+        fprintf(stderr, "Failed to create fake sysfs tree\n");
+        return EXIT_FAILURE;
+    }
+
+    check_platform_profile(t);
+    check_scoped_power_limit(t);
+    check_cpu_epp(t);
+    check_events();
+
+    pfs::acpi acpi {t.root()};
+    acpi.acquire();
+
+    check(acpi.batteries_available() == 1, "acpi: battery acquired");
+    check(acpi.ac_adapters_available() == 1, "acpi: AC adapter acquired");
+    check(acpi.thermal_zones_available() == 1, "acpi: thermal zone acquired");
+    check(acpi.fans_available() == 1, "acpi: fan acquired");
+    check(acpi.battery_at(0).percentage == 50, "acpi: battery percentage");
+
+    auto generation = acpi.generation();
+    auto acquisition_generation = acpi.acquisition_generation();
+    acpi.refresh();
+    check(acpi.generation() != generation && acpi.acquisition_generation() == acquisition_generation
+        , "acpi: refresh keeps acquisition generation");
+
+    if (acpi.fans_available() == 1) {
+        check_fan(acpi);
+        check_cooling_stats(t, acpi);
+    }
+
+    if (g_failures > 0) {
+        printf("%d check(s) failed\n", g_failures);
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
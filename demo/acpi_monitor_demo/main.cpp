@@ -0,0 +1,93 @@
+#include "pfs/acpi/monitor_client.hpp"
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+// Subscribes to monitoring daemon (`pfs-acpid`) and prints pushed changes.
+//
+// Usage: acpi_monitor_demo [--socket PATH] [-i INTERVAL_MS] [-n MESSAGES]
+//          [battery] [ac] [thermal] [fan]
+int main (int argc, char * argv[])
+{
+    namespace monitor = pfs::monitor;
+
+    std::string socket_path {monitor::DEFAULT_SOCKET_PATH};
+    std::uint32_t interval_ms = 1000;
+    int messages = 10;
+    int devices = pfs::acpi::dev_none;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--socket") == 0 && i + 1 < argc) {
+            socket_path = argv[++i];
+        } else if (strcmp(argv[i], "-i") == 0 && i + 1 < argc) {
+            interval_ms = static_cast<std::uint32_t>(atoi(argv[++i]));
+        } else if (strcmp(argv[i], "-n") == 0 && i + 1 < argc) {
+            messages = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "battery") == 0) {
+            devices |= pfs::acpi::dev_battery;
+        } else if (strcmp(argv[i], "ac") == 0) {
+            devices |= pfs::acpi::dev_ac_adapter;
+        } else if (strcmp(argv[i], "thermal") == 0) {
+            devices |= pfs::acpi::dev_thermal_zone;
+        } else if (strcmp(argv[i], "fan") == 0) {
+            devices |= pfs::acpi::dev_fan;
+        } else {
+            fprintf(stderr, "Usage: %s [--socket PATH] [-i INTERVAL_MS] [-n MESSAGES]"
+                " [battery] [ac] [thermal] [fan]\n", argv[0]);
+            return -1;
+        }
+    }
+
+    if (devices == pfs::acpi::dev_none)
+        devices = pfs::acpi::dev_all;
+
+    pfs::acpi_monitor_client client;
+
+    if (!client.connect(socket_path) || !client.subscribe(monitor::fields_of(devices), interval_ms)) {
+        fprintf(stderr, "Failed to subscribe: %s\n", socket_path.c_str());
+        return -1;
+    }
+
+    static char const * FIELD_NAMES[] = {
+        "percentage", "seconds", "rate", "charge_state", "online"
+        , "temperature", "cur_state", "max_state"
+    };
+
+    for (int i = 0; i < messages; i++) {
+        auto rc = client.receive(-1);
+
+        if (rc < 0) {
+            fprintf(stderr, "Disconnected\n");
+            return -1;
+        }
+
+        if (rc == monitor::msg_names) {
+            printf("devices:");
+
+            for (int c = 0; c < monitor::class_count; c++) {
+                auto device_class = static_cast<monitor::device_class_enum>(c);
+
+                for (size_t k = 0; k < client.devices_count(device_class); k++)
+                    printf(" %s", client.device_name(device_class, static_cast<int>(k)).c_str());
+            }
+
+            printf("\n");
+        } else if (rc == monitor::msg_delta) {
+            printf("generation %llu:", static_cast<unsigned long long>(client.generation()));
+
+            for (auto const & entry: client.changes()) {
+                auto field = static_cast<monitor::field_enum>(entry.field);
+                auto name = client.device_name(monitor::class_of(field), entry.index);
+
+                if (entry.value == monitor::VALUE_UNAVAILABLE)
+                    printf(" %s.%s=n/a", name.c_str(), FIELD_NAMES[field]);
+                else
+                    printf(" %s.%s=%d", name.c_str(), FIELD_NAMES[field], entry.value);
+            }
+
+            printf("\n");
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,109 @@
+#include "pfs/acpi/poller.hpp"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+
+// Runs library-owned polling thread and reports its own overhead.
+//
+// Usage: acpi_poller_demo [-i INTERVAL_MS] [-t SECONDS] [--cpus 0,1] [--idle]
+//          [--nice N] [--slack NS] [--thermal MS] [--power MS] [--low-power]
+//          [--grid MS] [--battery-factor N] [--budget WAKEUPS_PER_MINUTE]
+//
+// Returns non-zero if wakeups budget is exceeded.
+int main (int argc, char * argv[])
+{
+    pfs::poller_options options;
+    int seconds = 10;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-i") == 0 && i + 1 < argc) {
+            options.interval_ms = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "-t") == 0 && i + 1 < argc) {
+            seconds = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--cpus") == 0 && i + 1 < argc) {
+            for (char * p = argv[++i]; *p; ) {
+                char * endptr = nullptr;
+                options.cpus.push_back(static_cast<int>(strtol(p, & endptr, 10)));
+                p = *endptr == ',' ? endptr + 1 : endptr;
+
+                if (endptr == p && *p)
+                    break;
+            }
+        } else if (strcmp(argv[i], "--idle") == 0) {
+            options.sched = pfs::poller_options::sched_idle;
+        } else if (strcmp(argv[i], "--nice") == 0 && i + 1 < argc) {
+            options.nice = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--slack") == 0 && i + 1 < argc) {
+            options.timer_slack_ns = atol(argv[++i]);
+        } else if (strcmp(argv[i], "--thermal") == 0 && i + 1 < argc) {
+            options.class_intervals.push_back({pfs::acpi::dev_thermal, atoi(argv[++i])});
+        } else if (strcmp(argv[i], "--power") == 0 && i + 1 < argc) {
+            options.class_intervals.push_back({pfs::acpi::dev_power_supply, atoi(argv[++i])});
+        } else if (strcmp(argv[i], "--low-power") == 0) {
+            options.low_power = true;
+        } else if (strcmp(argv[i], "--grid") == 0 && i + 1 < argc) {
+            options.grid_ms = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--battery-factor") == 0 && i + 1 < argc) {
+            options.battery_interval_factor = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--budget") == 0 && i + 1 < argc) {
+            options.wakeups_per_minute = atoi(argv[++i]);
+        } else {
+            fprintf(stderr, "Usage: %s [-i INTERVAL_MS] [-t SECONDS] [--cpus 0,1] [--idle]"
+                " [--nice N] [--slack NS] [--thermal MS] [--power MS] [--low-power]"
+                " [--grid MS] [--battery-factor N] [--budget WAKEUPS_PER_MINUTE]\n", argv[0]);
+            return -1;
+        }
+    }
+
+    pfs::acpi acpi;
+    pfs::acpi_poller poller;
+
+    bool started = poller.start(acpi, options, [] (pfs::acpi const & a) {
+        float temperatures[16];
+        auto result = a.temperatures(temperatures, 16);
+
+        printf("generation %llu:", static_cast<unsigned long long>(result.generation));
+
+        for (size_t i = 0; i < result.count; i++)
+            printf(" %.1f", temperatures[i]);
+
+        printf("\n");
+    });
+
+    if (!started) {
+        fprintf(stderr, "Failed to start polling thread\n");
+        return -1;
+    }
+
+    std::this_thread::sleep_for(std::chrono::seconds(seconds));
+    poller.stop();
+
+    auto stats = poller.stats();
+
+    printf("Wakeups      : %llu (%.2f per second)\n"
+        , static_cast<unsigned long long>(stats.wakeups), stats.wakeups_per_second);
+    printf("Wakeup rate  : %.2f per minute\n", stats.wakeups_per_minute);
+    printf("Class updates: %llu\n", static_cast<unsigned long long>(stats.class_updates));
+    printf("On battery   : %s\n", stats.on_battery ? "yes" : "no");
+    printf("CPU time     : %.3f ms\n", stats.cpu_time_ns / 1e6);
+    printf("Last CPU     : %d\n", stats.last_cpu);
+    printf("CPUs         :");
+
+    for (int cpu = 0; cpu < 64; cpu++) {
+        if (stats.cpus_mask & (std::uint64_t{1} << cpu))
+            printf(" %d", cpu);
+    }
+
+    printf("\n");
+
+    // Initial acquisition is not postponed
+    if (options.wakeups_per_minute > 0
+            && stats.wakeups > 1 + static_cast<std::uint64_t>(seconds) * options.wakeups_per_minute / 60) {
+        fprintf(stderr, "Wakeups budget exceeded: %d per minute\n", options.wakeups_per_minute);
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,148 @@
+#include "pfs/acpi/realtime_reader.hpp"
+#include "../fake_sysfs.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <sched.h>
+#include <time.h>
+
+// Measures per-cycle latency of the realtime read path.
+//
+// Usage: acpi_realtime_demo [--fifo PRIORITY] [--mlock] [PERIOD_US CYCLES [ATTRIBUTE_PATH...]]
+//
+// Without attribute paths reads thermal zone temperature and RAPL energy
+// from fake sysfs tree (200 us period and 10000 cycles by default), so
+// latency percentiles are available on hosts without the hardware.
+//
+// For example, to read two thermal zones and RAPL package energy every 2 ms
+// for 10000 cycles with SCHED_FIFO priority 80 and locked memory:
+//
+//      acpi_realtime_demo --fifo 80 --mlock 2000 10000
+//          /sys/class/thermal/thermal_zone0/temp
+//          /sys/class/thermal/thermal_zone1/temp
+//          /sys/class/powercap/intel-rapl:0/energy_uj
+//
+// (arguments above are on one command line)
+
+static long long now_ns ()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, & ts);
+    return static_cast<long long>(ts.tv_sec) * 1000000000LL + ts.tv_nsec;
+}
+
+static void print_percentiles (char const * title, std::vector<long long> & samples)
+{
+    std::sort(samples.begin(), samples.end());
+
+    auto at = [& samples] (double p) {
+        auto index = static_cast<size_t>(p / 100 * (samples.size() - 1));
+        return samples[index] / 1000.0;
+    };
+
+    printf("%-13s: p50 %8.1f us, p99 %8.1f us, p99.9 %8.1f us, p99.99 %8.1f us, max %8.1f us\n"
+        , title, at(50), at(99), at(99.9), at(99.99), samples.back() / 1000.0);
+}
+
+int main (int argc, char * argv[])
+{
+    int priority = 0;
+    bool mlock = false;
+    int i = 1;
+
+    for (; i < argc; i++) {
+        if (strcmp(argv[i], "--fifo") == 0 && i + 1 < argc)
+            priority = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--mlock") == 0)
+            mlock = true;
+        else
+            break;
+    }
+
+    if (argc - i == 1) {
+        fprintf(stderr, "Usage: %s [--fifo PRIORITY] [--mlock] [PERIOD_US CYCLES [ATTRIBUTE_PATH...]]\n", argv[0]);
+        return -1;
+    }
+
+    long long period_ns = argc - i > 0 ? atoll(argv[i++]) * 1000 : 200000;
+    int cycles = argc - i > 0 ? atoi(argv[i++]) : 10000;
+
+    if (period_ns <= 0 || cycles <= 0) {
+        fprintf(stderr, "Bad period or cycles\n");
+        return -1;
+    }
+
+    fake_sysfs::tree t;
+    std::vector<std::string> paths {argv + i, argv + argc};
+    bool fake = paths.empty();
+
+    if (fake) {
+        if (!t.ok() || !fake_sysfs::populate_thermal(t) || !fake_sysfs::populate_powercap(t)) {
+            fprintf(stderr, "Failed to create fake sysfs tree\n");
+            return -1;
+        }
+
+        paths.push_back(t.path("class/thermal/thermal_zone0/temp"));
+        paths.push_back(t.path("class/powercap/intel-rapl:0/energy_uj"));
+    }
+
+    pfs::realtime_reader reader;
+
+    for (auto const & path: paths) {
+        if (reader.add_attribute(path) < 0) {
+            fprintf(stderr, "Failed to open attribute: %s\n", path.c_str());
+            return -1;
+        }
+    }
+
+    // All memory used by the loop is allocated before locking
+    std::vector<long long> values(reader.attributes_count());
+    std::vector<long long> read_latency(cycles);
+    std::vector<long long> wakeup_latency(cycles);
+
+    if (priority > 0) {
+        struct sched_param param;
+        param.sched_priority = priority;
+
+        if (sched_setscheduler(0, SCHED_FIFO, & param) != 0)
+            fprintf(stderr, "SCHED_FIFO is not set: %s\n", strerror(errno));
+    }
+
+    if (mlock && !pfs::realtime_reader::lock_memory())
+        fprintf(stderr, "Memory is not locked: %s\n", strerror(errno));
+
+    if (!reader.prepare())
+        fprintf(stderr, "Some attributes can't be read\n");
+
+    size_t errors = 0;
+    auto next = now_ns() + period_ns;
+
+    for (int cycle = 0; cycle < cycles; cycle++) {
+        struct timespec ts;
+        ts.tv_sec = static_cast<time_t>(next / 1000000000LL);
+        ts.tv_nsec = static_cast<long>(next % 1000000000LL);
+
+        while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, & ts, nullptr) == EINTR)
+            ;
+
+        auto start = now_ns();
+        errors += reader.attributes_count() - reader.read(values.data());
+        auto finish = now_ns();
+
+        wakeup_latency[cycle] = start - next;
+        read_latency[cycle] = finish - start;
+        next += period_ns;
+    }
+
+    printf("Cycles       : %d x %lld us, %zu attributes, %zu read errors\n"
+        , cycles, period_ns / 1000, reader.attributes_count(), errors);
+    print_percentiles("Read latency", read_latency);
+    print_percentiles("Wakeup jitter", wakeup_latency);
+
+    // Attributes of fake tree are always readable
+    return fake && errors > 0 ? 1 : 0;
+}
@@ -0,0 +1,119 @@
+#include "pfs/acpi.hpp"
+#include "../fake_sysfs.hpp"
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <dirent.h>
+
+// Checks that `acpi::refresh()` does not allocate memory: counts global
+// allocations during refresh cycles and fails if there are any or if no
+// devices were acquired.
+//
+// Usage: acpi_refresh_demo [CYCLES [SYSFS_ROOT]]
+//
+// Without SYSFS_ROOT runs against fake sysfs tree populated with every
+// device class.
+
+static std::atomic<long> g_allocations {0};
+
+void * operator new (std::size_t size)
+{
+    ++g_allocations;
+
+    if (auto p = std::malloc(size ? size : 1))
+        return p;
+
+    throw std::bad_alloc{};
+}
+
+void operator delete (void * p) noexcept
+{
+    std::free(p);
+}
+
+void operator delete (void * p, std::size_t) noexcept
+{
+    std::free(p);
+}
+
+static int open_fds ()
+{
+    int n = 0;
+    auto d = opendir("/proc/self/fd");
+
+    if (!d)
+        return -1;
+
+    while (readdir(d))
+        ++n;
+
+    closedir(d);
+    return n - 3; // ".", ".." and directory itself
+}
+
+int main (int argc, char * argv[])
+{
+    int cycles = argc > 1 ? atoi(argv[1]) : 1000;
+    fake_sysfs::tree t;
+    std::string sysfs_root;
+
+    if (argc > 2) {
+        sysfs_root = argv[2];
+    } else {
+        if (!t.ok() || !fake_sysfs::populate_power_supply(t) || !fake_sysfs::populate_ups(t)
+                || !fake_sysfs::populate_usb_power_supply(t) || !fake_sysfs::populate_thermal(t)
+                || !fake_sysfs::populate_cooling_device(t)) {
+            fprintf(stderr, "Failed to create fake sysfs tree\n");
+            return EXIT_FAILURE;
+        }
+
+        sysfs_root = t.root();
+    }
+
+    printf("Sysfs root   : %s\n", sysfs_root.c_str());
+
+    pfs::acpi acpi {sysfs_root};
+    auto fds = open_fds();
+
+    acpi.acquire();
+
+    printf("Devices      : %zu batteries, %zu AC adapters, %zu UPS, %zu USB, %zu zones, %zu fans\n"
+        , acpi.batteries_available(), acpi.ac_adapters_available(), acpi.ups_available()
+        , acpi.usb_power_supplies_available(), acpi.thermal_zones_available(), acpi.fans_available());
+    printf("Attribute fds: %d\n", open_fds() - fds);
+
+    auto devices = acpi.batteries_available() + acpi.ac_adapters_available() + acpi.ups_available()
+        + acpi.usb_power_supplies_available() + acpi.thermal_zones_available() + acpi.fans_available();
+
+    if (devices == 0) {
+        fprintf(stderr, "No devices acquired, nothing to check\n");
+        return EXIT_FAILURE;
+    }
+
+    // Fake tree has devices of every class, so refresh path of each class is checked
+    bool every_class = acpi.batteries_available() > 0 && acpi.ac_adapters_available() > 0
+        && acpi.ups_available() > 0 && acpi.usb_power_supplies_available() > 0
+        && acpi.thermal_zones_available() > 0 && acpi.fans_available() > 0;
+
+    if (sysfs_root == t.root() && !every_class) {
+        fprintf(stderr, "Devices of some class are not acquired from fake sysfs tree\n");
+        return EXIT_FAILURE;
+    }
+
+    // The first refresh is not counted: lazily initialized runtime
+    // facilities may allocate once
+    acpi.refresh();
+
+    auto allocations = g_allocations.load();
+
+    for (int i = 0; i < cycles; i++)
+        acpi.refresh();
+
+    allocations = g_allocations.load() - allocations;
+
+    printf("Refresh cycles: %d\n", cycles);
+    printf("Allocations   : %ld\n", allocations);
+
+    return allocations == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,126 @@
+#include "pfs/acpi/ring_log.hpp"
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <thread>
+
+// Writes samples into persistent ring log or prints records of existing log
+// (e.g. after crash or reboot).
+//
+// Usage: acpi_ring_log_demo write FILE [-c CAPACITY] [-i INTERVAL_MS] [-n COUNT]
+//        acpi_ring_log_demo read FILE [--csv]
+
+static int write_log (char const * path, size_t capacity, int interval_ms, int count)
+{
+    pfs::acpi acpi;
+    acpi.acquire(pfs::acpi::dev_all);
+
+    pfs::ring_log log;
+
+    if (!log.open(path, capacity, pfs::ring_log::acpi_sensor_names(acpi))) {
+        fprintf(stderr, "Failed to open log: %s\n", path);
+        return -1;
+    }
+
+    long long append_ns = 0;
+
+    for (int i = 0; count <= 0 || i < count; i++) {
+        if (i > 0) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(interval_ms));
+            acpi.refresh(pfs::acpi::dev_all);
+        }
+
+        auto start = std::chrono::steady_clock::now();
+        log.append(acpi);
+        append_ns += std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - start).count();
+    }
+
+    printf("Appended %d records, %.0f ns per append\n", count
+        , count > 0 ? static_cast<double>(append_ns) / count : 0.0);
+
+    return 0;
+}
+
+static int read_log (char const * path, bool csv)
+{
+    pfs::ring_log log;
+
+    if (!log.open(path)) {
+        fprintf(stderr, "Failed to open log or log is corrupted: %s\n", path);
+        return -1;
+    }
+
+    auto names = log.sensor_names();
+    auto records = log.records();
+    char const * separator = csv ? "," : " ";
+
+    if (!csv) {
+        printf("Capacity: %zu records, valid: %zu\n", log.capacity(), records.size());
+        printf("%-8s %-23s", "seq", "time");
+    } else {
+        printf("seq,timestamp_ns");
+    }
+
+    for (auto const & name: names)
+        printf("%s%s", separator, name.c_str());
+
+    printf("\n");
+
+    for (auto const & rec: records) {
+        if (csv) {
+            printf("%llu,%lld", static_cast<unsigned long long>(rec.seq)
+                , static_cast<long long>(rec.timestamp_ns));
+        } else {
+            char buf[32];
+            auto seconds = static_cast<time_t>(rec.timestamp_ns / 1000000000LL);
+            struct tm tm;
+            localtime_r(& seconds, & tm);
+            strftime(buf, sizeof(buf), "%Y-%m-%d %H:%M:%S", & tm);
+
+            printf("%-8llu %s.%03d", static_cast<unsigned long long>(rec.seq), buf
+                , static_cast<int>(rec.timestamp_ns / 1000000 % 1000));
+        }
+
+        for (std::uint32_t i = 0; i < rec.sensors; i++) {
+            if (std::isnan(rec.values[i]))
+                printf("%s-", separator);
+            else
+                printf("%s%g", separator, rec.values[i]);
+        }
+
+        printf("\n");
+    }
+
+    return 0;
+}
+
+int main (int argc, char * argv[])
+{
+    if (argc >= 3 && strcmp(argv[1], "write") == 0) {
+        size_t capacity = 36000; // 1 hour at 10 Hz
+        int interval_ms = 100;
+        int count = 100;
+
+        for (int i = 3; i < argc; i++) {
+            if (strcmp(argv[i], "-c") == 0 && i + 1 < argc)
+                capacity = static_cast<size_t>(atol(argv[++i]));
+            else if (strcmp(argv[i], "-i") == 0 && i + 1 < argc)
+                interval_ms = atoi(argv[++i]);
+            else if (strcmp(argv[i], "-n") == 0 && i + 1 < argc)
+                count = atoi(argv[++i]);
+        }
+
+        return write_log(argv[2], capacity, interval_ms, count);
+    }
+
+    if (argc >= 3 && strcmp(argv[1], "read") == 0)
+        return read_log(argv[2], argc > 3 && strcmp(argv[3], "--csv") == 0);
+
+    fprintf(stderr, "Usage: %s write FILE [-c CAPACITY] [-i INTERVAL_MS] [-n COUNT]\n"
+        "       %s read FILE [--csv]\n", argv[0], argv[0]);
+    return -1;
+}
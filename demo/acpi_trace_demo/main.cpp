@@ -0,0 +1,111 @@
+#include "pfs/acpi.hpp"
+#include "pfs/acpi/sysfs_trace.hpp"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+
+#if !PFS_ACPI_FIXED_CAPACITY
+#   include <iostream>
+#endif
+
+// Records sysfs reads of `acquire()` runs into trace file or replays trace
+// and measures acquisition cost without kernel involved.
+//
+// Usage: acpi_trace_demo record FILE [-n COUNT] [-i INTERVAL_MS] [--sysfs-root DIR]
+//        acpi_trace_demo replay FILE [-n COUNT] [--sysfs-root DIR] [--dump]
+//
+// Replay must use the same sysfs root as recording.
+
+static void print_summary (pfs::acpi const & acpi)
+{
+    printf("Batteries    : %zu\n", acpi.batteries_available());
+    printf("AC adapters  : %zu\n", acpi.ac_adapters_available());
+    printf("Thermal zones: %zu\n", acpi.thermal_zones_available());
+    printf("Fans         : %zu\n", acpi.fans_available());
+}
+
+int main (int argc, char * argv[])
+{
+    if (argc < 3 || (strcmp(argv[1], "record") != 0 && strcmp(argv[1], "replay") != 0)) {
+        fprintf(stderr, "Usage: %s record FILE [-n COUNT] [-i INTERVAL_MS] [--sysfs-root DIR]\n"
+            "       %s replay FILE [-n COUNT] [--sysfs-root DIR] [--dump]\n", argv[0], argv[0]);
+        return -1;
+    }
+
+    bool record = strcmp(argv[1], "record") == 0;
+    char const * path = argv[2];
+    int count = record ? 10 : 10000;
+    int interval_ms = 1000;
+    char const * sysfs_root = "/sys";
+    bool dump = false;
+
+    for (int i = 3; i < argc; i++) {
+        if (strcmp(argv[i], "-n") == 0 && i + 1 < argc)
+            count = atoi(argv[++i]);
+        else if (strcmp(argv[i], "-i") == 0 && i + 1 < argc)
+            interval_ms = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--sysfs-root") == 0 && i + 1 < argc)
+            sysfs_root = argv[++i];
+        else if (strcmp(argv[i], "--dump") == 0)
+            dump = true;
+    }
+
+    if (record) {
+        pfs::sysfs_trace::record();
+        pfs::acpi acpi {std::string{sysfs_root}};
+
+        for (int i = 0; i < count; i++) {
+            if (i > 0)
+                std::this_thread::sleep_for(std::chrono::milliseconds(interval_ms));
+
+            acpi.acquire(pfs::acpi::dev_all);
+        }
+
+        pfs::sysfs_trace::stop();
+
+        if (!pfs::sysfs_trace::save(path)) {
+            fprintf(stderr, "Failed to save trace: %s\n", path);
+            return -1;
+        }
+
+        print_summary(acpi);
+        printf("Paths        : %zu\n", pfs::sysfs_trace::paths());
+        printf("Reads        : %zu\n", pfs::sysfs_trace::reads());
+        return 0;
+    }
+
+    if (!pfs::sysfs_trace::load(path)) {
+        fprintf(stderr, "Failed to load trace: %s\n", path);
+        return -1;
+    }
+
+    pfs::sysfs_trace::replay();
+    pfs::acpi acpi {std::string{sysfs_root}};
+
+    auto start = std::chrono::steady_clock::now();
+
+    for (int i = 0; i < count; i++)
+        acpi.acquire(pfs::acpi::dev_all);
+
+    auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - start).count();
+
+    pfs::sysfs_trace::stop();
+
+    print_summary(acpi);
+    printf("Paths        : %zu\n", pfs::sysfs_trace::paths());
+    printf("Reads        : %zu\n", pfs::sysfs_trace::reads());
+    printf("Misses       : %zu\n", pfs::sysfs_trace::misses());
+    printf("Acquire      : %.0f ns\n", count > 0 ? static_cast<double>(elapsed) / count : 0.0);
+
+#if !PFS_ACPI_FIXED_CAPACITY
+    if (dump)
+        acpi.dump(std::cout, true);
+#else
+    (void)dump;
+#endif
+
+    return 0;
+}
@@ -0,0 +1,263 @@
+#pragma once
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <fcntl.h>
+#include <ftw.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+//
+// Fake sysfs tree in temporary directory for demos checking library
+// behaviour on machines without ACPI devices. Pass `root()` as sysfs root.
+//
+namespace fake_sysfs {
+
+class tree
+{
+public:
+    tree ()
+    {
+        char tmpl[] = "/tmp/pfs-acpi-sysfs-XXXXXX";
+
+        if (mkdtemp(tmpl))
+            _root = tmpl;
+    }
+
+    ~tree ()
+    {
+        if (!_root.empty())
+            nftw(_root.c_str(), remove_entry, 16, FTW_DEPTH | FTW_PHYS);
+    }
+
+    tree (tree const &) = delete;
+    tree & operator = (tree const &) = delete;
+
+    bool ok () const
+    {
+        return !_root.empty();
+    }
+
+    std::string const & root () const
+    {
+        return _root;
+    }
+
+    std::string path (std::string const & rel) const
+    {
+        return _root + '/' + rel;
+    }
+
+    // Creates directory with all parents
+    bool make_dir (std::string const & rel) const
+    {
+        auto p = path(rel);
+
+        for (auto pos = _root.size(); pos != std::string::npos; ) {
+            pos = p.find('/', pos + 1);
+            auto dir = p.substr(0, pos);
+
+            if (::mkdir(dir.c_str(), 0755) != 0 && errno != EEXIST)
+                return false;
+        }
+
+        return true;
+    }
+
+    // Replaces file content (creates parent directories)
+    bool write (std::string const & rel, std::string const & value) const
+    {
+        auto slash = rel.rfind('/');
+
+        if (slash != std::string::npos && !make_dir(rel.substr(0, slash)))
+            return false;
+
+        auto fd = ::open(path(rel).c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+
+        if (fd < 0)
+            return false;
+
+        auto n = ::write(fd, value.data(), value.size());
+        ::close(fd);
+        return n == static_cast<ssize_t>(value.size());
+    }
+
+    // Creates symbolic link `rel` pointing to `target`
+    bool link (std::string const & rel, std::string const & target) const
+    {
+        auto slash = rel.rfind('/');
+
+        if (slash != std::string::npos && !make_dir(rel.substr(0, slash)))
+            return false;
+
+        return ::symlink(target.c_str(), path(rel).c_str()) == 0;
+    }
+
+    std::string read (std::string const & rel) const
+    {
+        std::string result;
+        auto fd = ::open(path(rel).c_str(), O_RDONLY | O_CLOEXEC);
+
+        if (fd < 0)
+            return result;
+
+        char buf[256];
+        ssize_t n = 0;
+
+        while ((n = ::read(fd, buf, sizeof(buf))) > 0)
+            result.append(buf, static_cast<std::size_t>(n));
+
+        ::close(fd);
+        return result;
+    }
+
+    // Sysfs attribute stores the value written, while regular file written
+    // at offset 0 keeps the tail of the longer previous value. Keeps only
+    // `size` bytes written by the library.
+    bool commit_write (std::string const & rel, std::size_t size) const
+    {
+        auto value = read(rel);
+
+        if (value.size() < size)
+            return false;
+
+        return write(rel, value.substr(0, size));
+    }
+
+private:
+    static int remove_entry (char const * path, struct stat const *, int, struct FTW *)
+    {
+        return ::remove(path);
+    }
+
+private:
+    std::string _root;
+};
+
+// Binds class device `rel` (e.g. `class/power_supply/BAT0`) to ACPI device
+// `bus_id` (e.g. `PNP0C0A:00`) with `device` link as the kernel does.
+inline bool bind_acpi_device (tree const & t, std::string const & rel, std::string const & bus_id)
+{
+    std::string const acpi_dev = "devices/LNXSYSTM:00/LNXSYBUS:00/" + bus_id;
+    std::string target;
+
+    for (auto c: rel) {
+        if (c == '/')
+            target += "../";
+    }
+
+    return t.make_dir(acpi_dev) && t.link(rel + "/device", target + "../" + acpi_dev);
+}
+
+// Battery BAT0 (discharging, 50%) and AC adapter
+inline bool populate_power_supply (tree const & t)
+{
+    return t.write("class/power_supply/BAT0/type", "Battery\n")
+        && t.write("class/power_supply/BAT0/status", "Discharging\n")
+        && t.write("class/power_supply/BAT0/charge_now", "2000000\n")
+        && t.write("class/power_supply/BAT0/charge_full", "4000000\n")
+        && t.write("class/power_supply/BAT0/current_now", "1000000\n")
+        && t.write("class/power_supply/BAT0/voltage_now", "12000000\n")
+        && t.write("class/power_supply/BAT0/manufacturer", "ACME\n")
+        && t.write("class/power_supply/BAT0/model_name", "Fake\n")
+        && t.write("class/power_supply/BAT0/technology", "Li-ion\n")
+        && t.write("class/power_supply/AC/type", "Mains\n")
+        && t.write("class/power_supply/AC/online", "0\n");
+}
+
+// UPS on battery (discharging, 80%, 20 minutes left)
+inline bool populate_ups (tree const & t)
+{
+    std::string const dev = "class/power_supply/ups0";
+
+    return t.write(dev + "/type", "UPS\n")
+        && t.write(dev + "/online", "0\n")
+        && t.write(dev + "/status", "Discharging\n")
+        && t.write(dev + "/capacity", "80\n")
+        && t.write(dev + "/time_to_empty_now", "1200\n")
+        && t.write(dev + "/power_now", "150000000\n")
+        && t.write(dev + "/manufacturer", "ACME\n")
+        && t.write(dev + "/model_name", "Fake UPS\n");
+}
+
+// USB Power Delivery port negotiated at 20 V / 3 A
+inline bool populate_usb_power_supply (tree const & t)
+{
+    std::string const dev = "class/power_supply/ucsi-source-psy-USBC000:001";
+
+    return t.write(dev + "/type", "USB\n")
+        && t.write(dev + "/usb_type", "C PD [PD_PPS]\n")
+        && t.write(dev + "/online", "1\n")
+        && t.write(dev + "/voltage_now", "20000000\n")
+        && t.write(dev + "/current_max", "3000000\n");
+}
+
+// Thermal zone at 45 degrees with critical trip point
+inline bool populate_thermal (tree const & t)
+{
+    return t.write("class/thermal/thermal_zone0/temp", "45000\n")
+        && t.write("class/thermal/thermal_zone0/trip_point_0_type", "critical\n")
+        && t.write("class/thermal/thermal_zone0/trip_point_0_temp", "100000\n");
+}
+
+// ACPI 4.0 fan with statistics of two states laid out like the kernel's:
+// cooling device is bound to platform device, fan attributes are on its
+// ACPI companion (`firmware_node`).
+inline bool populate_cooling_device (tree const & t)
+{
+    std::string const dev = "devices/virtual/thermal/cooling_device0";
+    std::string const acpi_dev = "devices/LNXSYSTM:00/LNXSYBUS:00/PNP0C0B:00";
+
+    return t.write(dev + "/type", "Fan\n")
+        && t.write(dev + "/max_state", "1\n")
+        && t.write(dev + "/cur_state", "1\n")
+        && t.write(dev + "/stats/total_trans", "3\n")
+        && t.write(dev + "/stats/time_in_state_ms", "state0 100\nstate1 200\n")
+        && t.write(dev + "/stats/trans_table"
+            , " From  :    To\n       :    state0    state1\n"
+              "state0:         0         2\nstate1:         1         0\n")
+        && t.write(acpi_dev + "/fan_speed_rpm", "1900\n")
+        && t.write(acpi_dev + "/state0", "0:not-defined:1000:not-defined:500\n")
+        && t.write(acpi_dev + "/state1", "1:not-defined:2000:not-defined:1500\n")
+        && t.write(acpi_dev + "/fine_grain_control", "0\n")
+        && t.make_dir("devices/platform/PNP0C0B:00")
+        && t.link("devices/platform/PNP0C0B:00/firmware_node", "../../LNXSYSTM:00/LNXSYBUS:00/PNP0C0B:00")
+        && t.link(dev + "/device", "../../../platform/PNP0C0B:00")
+        && t.link("class/thermal/cooling_device0", "../../devices/virtual/thermal/cooling_device0");
+}
+
+// RAPL package domain with long term constraint
+inline bool populate_powercap (tree const & t)
+{
+    std::string const zone = "class/powercap/intel-rapl:0";
+
+    return t.write(zone + "/name", "package-0\n")
+        && t.write(zone + "/enabled", "1\n")
+        && t.write(zone + "/energy_uj", "1000000\n")
+        && t.write(zone + "/max_energy_range_uj", "262143328850\n")
+        && t.write(zone + "/constraint_0_name", "long_term\n")
+        && t.write(zone + "/constraint_0_power_limit_uw", "15000000\n")
+        && t.write(zone + "/constraint_0_time_window_us", "27983872\n")
+        && t.write(zone + "/constraint_0_max_power_uw", "25000000\n");
+}
+
+// Two CPUs with EPP: cpu0 with preference name, cpu1 with raw numeric value
+inline bool populate_cpu_epp (tree const & t)
+{
+    std::string const available = "default performance balance_performance balance_power power\n";
+
+    return t.write("devices/system/cpu/cpu0/cpufreq/energy_performance_available_preferences", available)
+        && t.write("devices/system/cpu/cpu0/cpufreq/energy_performance_preference", "balance_performance\n")
+        && t.write("devices/system/cpu/cpu1/cpufreq/energy_performance_available_preferences", available)
+        && t.write("devices/system/cpu/cpu1/cpufreq/energy_performance_preference", "128\n");
+}
+
+inline bool populate_platform_profile (tree const & t)
+{
+    return t.write("firmware/acpi/platform_profile_choices", "quiet balanced performance\n")
+        && t.write("firmware/acpi/platform_profile", "performance\n");
+}
+
+} // namespace fake_sysfs
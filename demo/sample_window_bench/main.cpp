@@ -0,0 +1,101 @@
+#include "pfs/acpi/sample_window.hpp"
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+// Compares statistics calculation over per-sensor sample window using
+// scalar, SSE2 and AVX2 kernels with the loop over array of structures.
+//
+// Usage: sample_window_bench [SENSORS [SAMPLES [ITERATIONS]]]
+
+static double elapsed_us (std::chrono::steady_clock::time_point start, int iterations)
+{
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    return std::chrono::duration<double, std::micro>(elapsed).count() / iterations;
+}
+
+int main (int argc, char * argv[])
+{
+    size_t sensors = argc > 1 ? atoi(argv[1]) : 300;
+    size_t samples = argc > 2 ? atoi(argv[2]) : 600;
+    int iterations = argc > 3 ? atoi(argv[3]) : 100;
+
+    pfs::sample_window window {sensors, samples};
+
+    // Baseline: rows of samples as returned by sequential acquisitions
+    std::vector<std::vector<float>> rows(samples, std::vector<float>(sensors));
+
+    srand(1);
+
+    for (size_t i = 0; i < samples; i++) {
+        for (size_t j = 0; j < sensors; j++)
+            rows[i][j] = 40 + (rand() % 4000) / float{100.0};
+
+        window.append(rows[i].data());
+    }
+
+    std::vector<pfs::window_stats> stats(sensors);
+    float checksum = 0;
+
+    auto start = std::chrono::steady_clock::now();
+
+    for (int k = 0; k < iterations; k++) {
+        for (size_t j = 0; j < sensors; j++) {
+            float sum = 0, min = rows[0][j], max = rows[0][j];
+
+            for (size_t i = 0; i < samples; i++) {
+                auto v = rows[i][j];
+                sum += v;
+                min = v < min ? v : min;
+                max = v > max ? v : max;
+            }
+
+            float mean = sum / samples;
+            float ssd = 0;
+
+            for (size_t i = 0; i < samples; i++) {
+                auto d = rows[i][j] - mean;
+                ssd += d * d;
+            }
+
+            checksum += mean + min + max + std::sqrt(ssd / samples);
+        }
+    }
+
+    std::cout << "Array of structures loop: " << elapsed_us(start, iterations) << " us\n";
+
+    struct {
+        pfs::sample_window::simd_enum simd;
+        char const * name;
+    } kernels[] = {
+          { pfs::sample_window::simd_scalar, "Scalar kernels          " }
+        , { pfs::sample_window::simd_sse2  , "SSE2 kernels            " }
+        , { pfs::sample_window::simd_avx2  , "AVX2 kernels            " }
+    };
+
+    for (auto const & kernel: kernels) {
+        if (!window.set_simd(kernel.simd)) {
+            std::cout << kernel.name << ": not supported\n";
+            continue;
+        }
+
+        start = std::chrono::steady_clock::now();
+
+        for (int k = 0; k < iterations; k++) {
+            window.stats(stats.data());
+            checksum += stats[0].mean;
+        }
+
+        std::cout << kernel.name << ": " << elapsed_us(start, iterations) << " us\n";
+    }
+
+    std::cout << "Sensor 0: mean " << stats[0].mean
+        << ", min " << stats[0].min
+        << ", max " << stats[0].max
+        << ", stddev " << stats[0].stddev
+        << ", p95 " << window.percentile(0, 95) << "\n";
+
+    return checksum == 0 ? 1 : 0;
+}
@@ -7,12 +7,83 @@
 //      2020.04.10 Initial version
 ////////////////////////////////////////////////////////////////////////////////
 #pragma once
+#include <cstdint>
 #include <memory>
 #include <string>
-#include <ostream>
+#include <vector>
+
+#if PFS_ACPI_PMR
+#   include <memory_resource>
+#elif PFS_ACPI_FIXED_CAPACITY
+#   include "pfs/acpi/fixed_containers.hpp"
+#endif
+
+#if !PFS_ACPI_FIXED_CAPACITY
+#   include <ostream>
+#endif
 
 namespace pfs {
 
+// Strings and vectors of the acquired data. If library is built with
+// `PFS_ACPI_PMR` (CMake option `pfs-acpi_ENABLE_PMR`, requires C++17) they
+// are allocated from memory resource specified for `acpi` instance.
+#if PFS_ACPI_PMR
+using acpi_string = std::pmr::string;
+template <typename T> using acpi_vector = std::pmr::vector<T>;
+using acpi_allocator = std::pmr::polymorphic_allocator<char>;
+
+// Makes data structure allocator-aware: `T(alloc)` and allocator-extended
+// copy/move constructors copy data into memory of specified allocator.
+#   define PFS_ACPI_ALLOCATOR_AWARE(T)                                            \
+    using allocator_type = acpi_allocator;                                        \
+    T () = default;                                                               \
+    T (T const &) = default;                                                      \
+    T (T &&) = default;                                                           \
+    T & operator = (T const &) = default;                                         \
+    T & operator = (T &&) = default;                                              \
+    T (T const & other, allocator_type alloc) : T(alloc) { *this = other; }       \
+    T (T && other, allocator_type alloc) : T(alloc) { *this = std::move(other); }
+#elif PFS_ACPI_FIXED_CAPACITY
+// Heap-free profile (CMake option `pfs-acpi_FIXED_CAPACITY`): data is stored
+// in inline containers of compile-time capacity, `dump()` is not available.
+#   ifndef PFS_ACPI_MAX_DEVICES
+#       define PFS_ACPI_MAX_DEVICES 8 // per device class
+#   endif
+#   ifndef PFS_ACPI_MAX_NAME
+#       define PFS_ACPI_MAX_NAME 32   // including terminating nul
+#   endif
+#   ifndef PFS_ACPI_MAX_STATES
+#       define PFS_ACPI_MAX_STATES 8  // fan performance / cooling states
+#   endif
+
+struct fan_performance_state;
+
+template <typename T>
+struct acpi_capacity
+{
+    static constexpr std::size_t value = PFS_ACPI_MAX_DEVICES;
+};
+
+template <>
+struct acpi_capacity<fan_performance_state>
+{
+    static constexpr std::size_t value = PFS_ACPI_MAX_STATES;
+};
+
+// Cooling statistics (transitions table is a square matrix)
+template <>
+struct acpi_capacity<unsigned long long>
+{
+    static constexpr std::size_t value = PFS_ACPI_MAX_STATES * PFS_ACPI_MAX_STATES;
+};
+
+using acpi_string = fixed_string<PFS_ACPI_MAX_NAME>;
+template <typename T> using acpi_vector = fixed_vector<T, acpi_capacity<T>::value>;
+#else
+using acpi_string = std::string;
+template <typename T> using acpi_vector = std::vector<T>;
+#endif
+
 enum class charge_state_enum
 {
       unknown   //!< hardware doesn't give information about the state
@@ -23,15 +94,25 @@ enum class charge_state_enum
 
 struct battery
 {
-    std::string name;
-    std::string manufacturer;
-    std::string model_name;
-    std::string technology;
-    charge_state_enum charge_state;
-    int percentage;
-    int seconds; // seconds until charged or remaining according `charge_state`
-                 // or -1 if rate information unavailable
-                 // or charging at zero rate or discharging at zero rate
+    acpi_string name;
+    acpi_string manufacturer;
+    acpi_string model_name;
+    acpi_string technology;
+    charge_state_enum charge_state {charge_state_enum::unknown};
+    int percentage {0};
+    int seconds {0}; // seconds until charged or remaining according `charge_state`
+                     // or -1 if rate information unavailable
+                     // or charging at zero rate or discharging at zero rate
+
+#if PFS_ACPI_PMR
+    PFS_ACPI_ALLOCATOR_AWARE(battery)
+    explicit battery (allocator_type alloc)
+        : name(alloc)
+        , manufacturer(alloc)
+        , model_name(alloc)
+        , technology(alloc)
+    {}
+#endif
 };
 
 enum class ac_state_enum
@@ -43,21 +124,154 @@ enum class ac_state_enum
 
 struct ac_adapter
 {
-    std::string name;
-    ac_state_enum state;
+    acpi_string name;
+    ac_state_enum state {ac_state_enum::unknown};
+
+#if PFS_ACPI_PMR
+    PFS_ACPI_ALLOCATOR_AWARE(ac_adapter)
+    explicit ac_adapter (allocator_type alloc) : name(alloc) {}
+#endif
+};
+
+struct ups
+{
+    acpi_string name;
+    acpi_string manufacturer;
+    acpi_string model_name;
+    ac_state_enum state {ac_state_enum::unknown}; // on-line if UPS is powered from mains
+    charge_state_enum charge_state {charge_state_enum::unknown};
+    int percentage {0}; // capacity or -1 if unavailable
+    int seconds {0};    // seconds until empty (discharging) or full (charging)
+                        // or -1 if unavailable
+    int power {0};      // present power draw in mW or -1 if unavailable
+
+#if PFS_ACPI_PMR
+    PFS_ACPI_ALLOCATOR_AWARE(ups)
+    explicit ups (allocator_type alloc)
+        : name(alloc)
+        , manufacturer(alloc)
+        , model_name(alloc)
+    {}
+#endif
+};
+
+struct usb_power_supply
+{
+    acpi_string name;
+    acpi_string type;      // power supply type, e.g. `USB`, `USB_PD`
+    acpi_string usb_type;  // negotiated USB type, e.g. `PD`, `DCP`
+    ac_state_enum state {ac_state_enum::unknown};
+    int voltage {0};             // negotiated voltage in mV or -1 if unavailable
+    int current_max {0};         // maximum current in mA or -1 if unavailable
+    int input_current_limit {0}; // input current limit in mA or -1 if unavailable
+    int input_power {0};         // available input power budget in mW or -1 if unavailable
+
+#if PFS_ACPI_PMR
+    PFS_ACPI_ALLOCATOR_AWARE(usb_power_supply)
+    explicit usb_power_supply (allocator_type alloc)
+        : name(alloc)
+        , type(alloc)
+        , usb_type(alloc)
+    {}
+#endif
 };
 
 struct thermal_zone
 {
-    std::string name;
-    float temperature; // in degrees Celsius
+    acpi_string name;
+    float temperature {0}; // in degrees Celsius
+
+#if PFS_ACPI_PMR
+    PFS_ACPI_ALLOCATOR_AWARE(thermal_zone)
+    explicit thermal_zone (allocator_type alloc) : name(alloc) {}
+#endif
+};
+
+// Thermal zone temperature trend and time-to-trip estimation
+struct thermal_trend
+{
+    acpi_string name;
+    float passive_temperature {0};  // passive trip point in degrees Celsius or -1 if not defined
+    float critical_temperature {0}; // critical trip point in degrees Celsius or -1 if not defined
+    float slope {0};                // temperature slope in degrees Celsius per second
+    int samples {0};                // number of samples the slope is estimated on
+    float seconds_to_passive {0};   // estimated seconds until passive trip point is reached
+                                    // at current slope, 0 if already reached
+                                    // or -1 if zone is not heating up or estimation unavailable
+    float seconds_to_critical {0};  // the same for critical trip point
+
+#if PFS_ACPI_PMR
+    PFS_ACPI_ALLOCATOR_AWARE(thermal_trend)
+    explicit thermal_trend (allocator_type alloc) : name(alloc) {}
+#endif
+};
+
+// ACPI 4.0 fan performance state (_FPS package entry)
+struct fan_performance_state
+{
+    int control;     // control value (percent of full speed if fine grain control is supported)
+    int trip_point;  // or -1 if not defined
+    int rpm;         // or -1 if not defined
+    int noise_level; // as reported by kernel (hundredths of ACPI value) or -1 if not defined
+    int power;       // in mW or -1 if not defined
 };
 
 struct fan
 {
-    std::string name;
-    int cur_state;
-    int max_state;
+    acpi_string name;
+    acpi_string type; // cooling device type, e.g. `Fan`, `Processor`
+    int cur_state {0};
+    int max_state {0};
+
+    // ACPI 4.0 fans only
+    int rpm {0};   // current speed in RPM or -1 if unavailable
+    int power {0}; // power of the current performance state in mW or -1 if unavailable
+    bool fine_grain_control {false};
+    acpi_vector<fan_performance_state> performance_states;
+
+#if PFS_ACPI_PMR
+    PFS_ACPI_ALLOCATOR_AWARE(fan)
+    explicit fan (allocator_type alloc)
+        : name(alloc)
+        , type(alloc)
+        , performance_states(alloc)
+    {}
+#endif
+};
+
+// Cooling device statistics (CONFIG_THERMAL_STATISTICS)
+struct cooling_stats
+{
+    acpi_string name;
+    int total_trans {0}; // total number of state transitions or -1 if statistics unavailable
+    int trans_delta {0}; // state transitions since previous acquisition or refresh
+
+    // Time spent in each state (milliseconds)
+    acpi_vector<unsigned long long> time_in_state_ms;
+
+    // Time spent in each state since previous acquisition or refresh (milliseconds)
+    acpi_vector<unsigned long long> time_in_state_delta_ms;
+
+    // Number of transitions from state `i` to state `j` stored
+    // at `i * states + j` (row-major square matrix)
+    acpi_vector<unsigned long long> trans_table;
+
+#if PFS_ACPI_PMR
+    PFS_ACPI_ALLOCATOR_AWARE(cooling_stats)
+    explicit cooling_stats (allocator_type alloc)
+        : name(alloc)
+        , time_in_state_ms(alloc)
+        , time_in_state_delta_ms(alloc)
+        , trans_table(alloc)
+    {}
+#endif
+};
+
+// Result of bulk copy-out
+struct copy_result
+{
+    size_t count;             // number of elements written
+    std::uint64_t generation; // generation of the data (see `acpi::generation()`)
 };
 
 namespace details {
@@ -73,25 +287,99 @@ public:
         , dev_ac_adapter   = 1 << 1
         , dev_thermal_zone = 1 << 2
         , dev_fan          = 1 << 3
+        , dev_ups          = 1 << 4
+        , dev_usb_power_supply = 1 << 5
         , dev_cooling = dev_fan
-        , dev_all = dev_battery | dev_ac_adapter | dev_thermal_zone | dev_fan
+        , dev_power_supply = dev_battery | dev_ac_adapter | dev_ups | dev_usb_power_supply
+        , dev_thermal = dev_thermal_zone | dev_fan
+        , dev_all = dev_power_supply | dev_thermal
     };
 
 public:
     acpi ();
+
+    // Devices are looked up under `sysfs_root` instead of `/sys`
+    // (e.g. fake sysfs tree for testing).
+    explicit acpi (std::string const & sysfs_root);
+
+#if PFS_ACPI_PMR
+    // All data of the instance (including returned by accessors) is allocated
+    // from `mr`, it must outlive the instance and the returned data.
+    explicit acpi (std::pmr::memory_resource * mr);
+    acpi (std::string const & sysfs_root, std::pmr::memory_resource * mr);
+
+    std::pmr::memory_resource * resource () const;
+#endif
+
     ~acpi ();
 
     void acquire (int devices = dev_all);
+
+    // Re-reads dynamic readings (states, charge, rates, temperatures, fan
+    // speeds, cooling transitions and time in state) of the already acquired
+    // devices through attribute files opened by `acquire()`. Does not
+    // allocate memory or build paths, so it is intended for periodic polling,
+    // while `acquire()` is called to discover devices (at startup and on
+    // hotplug events). Static attributes (names, trip points, performance
+    // states) and cooling transition table are updated by `acquire()` only.
+    void refresh (int devices = dev_all);
+
+    // Re-reads only the devices of specified classes bound to ACPI device
+    // `bus_id` (e.g. `PNP0C0A:00`). Acquires the whole class if there is no
+    // such device acquired yet.
+    void acquire (int devices, std::string const & bus_id);
+
     size_t batteries_available () const;
     size_t ac_adapters_available () const;
+    size_t ups_available () const;
+    size_t usb_power_supplies_available () const;
     size_t thermal_zones_available () const;
     size_t fans_available () const;
     battery battery_at (int index) const;
     ac_adapter ac_adapter_at (int index) const;
+    ups ups_at (int index) const;
+    usb_power_supply usb_power_supply_at (int index) const;
     thermal_zone thermal_zone_at (int index) const;
+    thermal_trend thermal_trend_at (int index) const;
+
+    // Copies temperatures of acquired thermal zones (in millidegrees Celsius),
+    // their acquisition timestamps (CLOCK_MONOTONIC, nanoseconds) and validity
+    // bits into caller arrays of `capacity` elements (`(capacity + 63) / 64`
+    // words for `valid`). Temperature of invalid zone is set to INT32_MIN.
+    // Returns number of zones copied (see `pfs::thermal_snapshot`).
+    size_t thermal_zones_soa (std::int32_t * millidegrees
+        , std::int64_t * timestamps_ns
+        , std::uint64_t * valid
+        , size_t capacity) const;
+
+    acpi_vector<acpi_string> thermal_zone_names () const;
+
+    // Generation number incremented by each acquisition, allows to detect
+    // whether data has changed since the previous copy-out.
+    std::uint64_t generation () const;
+
+    // Generation number incremented by acquisition only (not by refresh),
+    // allows to detect whether the set of devices or their names may have
+    // changed (e.g. to invalidate cached names).
+    std::uint64_t acquisition_generation () const;
+
+    // Bulk copy-out of readings straight into caller memory of `capacity`
+    // elements, in the same order as `*_at()` accessors.
+    copy_result temperatures (float * out, size_t capacity) const;
+    copy_result battery_percentages (int * out, size_t capacity) const;
+
+    // Present charge/discharge rate in mA (or mW if voltage is unavailable)
+    // or -1 if unavailable
+    copy_result battery_rates (int * out, size_t capacity) const;
+
+    // `max_states` may be null
+    copy_result fan_states (int * cur_states, int * max_states, size_t capacity) const;
     fan fan_at (int index) const;
+    cooling_stats cooling_stats_at (int index) const;
 
+#if !PFS_ACPI_FIXED_CAPACITY
     void dump (std::ostream & out, bool extended_data = false);
+#endif
 
     static bool has_acpi_support ();
 
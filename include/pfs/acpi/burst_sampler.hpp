@@ -0,0 +1,82 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026 Vladislav Trifochkin
+//
+// This file is part of [pfs-acpi](https://github.com/semenovf/pfs-acpi) library.
+//
+// Changelog:
+//      2026.10.17 Initial version
+//      2026.10.17 Invalid rate is rejected, rate is limited by `MAX_RATE`
+////////////////////////////////////////////////////////////////////////////////
+#pragma once
+#include <climits>
+#include <memory>
+#include <string>
+
+namespace pfs {
+
+struct burst_stats
+{
+    double requested_rate;     // in Hz or -1 if requested rate is invalid
+    double achieved_rate;      // in Hz
+    size_t samples;
+    long long duration_ns;
+    long long max_interval_ns; // the longest interval between consecutive samples
+    size_t read_errors;
+};
+
+namespace details {
+class burst_sampler;
+}
+
+//
+// High-frequency capture of a small set of numeric attributes (e.g. RAPL
+// `energy_uj`, thermal zone `temp`) for a bounded duration. Attributes are
+// opened in advance and samples are stored into a preallocated buffer, so
+// each sample costs one pread() per attribute and no allocation.
+//
+class burst_sampler
+{
+public:
+    enum wait_enum {
+          wait_sleep     //!< clock_nanosleep() until the next deadline
+        , wait_busy_poll //!< spin on clock_gettime() until the next deadline
+    };
+
+    static constexpr long long INVALID_VALUE = LLONG_MIN;
+
+    // Higher rates are clamped: sampling period is not less than 100 us,
+    // it is 10 times the rate of millisecond-scale transients capture
+    static constexpr double MAX_RATE = 1e4;
+
+public:
+    burst_sampler ();
+    ~burst_sampler ();
+
+    // Opens attribute to sample. Returns attribute index or -1 on error.
+    // Buffer must be reserved again after adding attributes.
+    int add_attribute (std::string const & path);
+    size_t attributes_count () const;
+
+    // Preallocates buffer for `max_samples` samples.
+    void reserve (size_t max_samples);
+    size_t capacity () const;
+
+    // Samples all attributes at `rate_hz` (limited by `MAX_RATE`) for
+    // `duration_ms` or until buffer is full. Previously captured samples are
+    // discarded. Nothing is sampled and `requested_rate` of the result is -1
+    // if `rate_hz` is not positive.
+    burst_stats run (double rate_hz, int duration_ms, wait_enum wait = wait_sleep);
+
+    size_t samples_count () const;
+
+    // Returns CLOCK_MONOTONIC timestamp of the sample in nanoseconds.
+    long long timestamp_at (size_t sample) const;
+
+    // Returns value of the attribute or `INVALID_VALUE` if read failed.
+    long long value_at (size_t sample, int attribute) const;
+
+private:
+    std::unique_ptr<details::burst_sampler> _d;
+};
+
+} // namespace pfs
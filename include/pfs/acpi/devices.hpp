@@ -0,0 +1,91 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026 Vladislav Trifochkin
+//
+// This file is part of [pfs-acpi](https://github.com/semenovf/pfs-acpi) library.
+//
+// Changelog:
+//      2026.10.17 Initial version
+////////////////////////////////////////////////////////////////////////////////
+#pragma once
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace pfs {
+
+enum class power_state_enum
+{
+      unknown //!< power state is not available or not recognized
+    , d0      //!< fully on
+    , d1
+    , d2
+    , d3hot
+    , d3cold
+};
+
+struct acpi_device
+{
+    std::string name; // sysfs entry name, e.g. `PNP0C0A:00`
+    std::string hid;  // hardware ID, e.g. `PNP0C0A`
+    std::string path; // ACPI namespace path, e.g. `\_SB_.PCI0.LPCB.BAT0`
+    int status;       // _STA value or -1 if not available
+    power_state_enum power_state;
+    power_state_enum real_power_state;
+};
+
+namespace details {
+class acpi_devices;
+}
+
+//
+// View of ACPI device namespace (/sys/bus/acpi/devices).
+// Devices are discovered once by `discover()`, subsequent calls of `refresh()`
+// re-read power states only using cached file descriptors.
+//
+class acpi_devices
+{
+public:
+    acpi_devices ();
+    explicit acpi_devices (std::string const & sysfs_root);
+    ~acpi_devices ();
+
+    void discover ();
+    void refresh ();
+
+    size_t devices_available () const;
+    acpi_device device_at (int index) const;
+
+    // Returns index of the device with specified ACPI path or -1 if not found.
+    int find_by_path (std::string const & path) const;
+
+    // Returns indices of the devices with specified hardware ID.
+    std::vector<int> find_by_hid (std::string const & hid) const;
+
+    // Returns indices of the devices in the specified power state.
+    std::vector<int> find_by_power_state (power_state_enum state) const;
+
+private:
+    std::unique_ptr<details::acpi_devices> _d;
+};
+
+inline std::string to_string (power_state_enum state)
+{
+    switch (state) {
+        case power_state_enum::d0:
+            return "D0";
+        case power_state_enum::d1:
+            return "D1";
+        case power_state_enum::d2:
+            return "D2";
+        case power_state_enum::d3hot:
+            return "D3hot";
+        case power_state_enum::d3cold:
+            return "D3cold";
+        case power_state_enum::unknown:
+            break;
+    }
+
+    return "unknown";
+}
+
+} // namespace pfs
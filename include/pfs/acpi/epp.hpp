@@ -0,0 +1,105 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026 Vladislav Trifochkin
+//
+// This file is part of [pfs-acpi](https://github.com/semenovf/pfs-acpi) library.
+//
+// Changelog:
+//      2026.10.17 Initial version
+//      2026.10.17 Raw values are saved and restored by `scoped_cpu_epp`
+////////////////////////////////////////////////////////////////////////////////
+#pragma once
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace pfs {
+
+namespace details {
+class cpu_epp;
+}
+
+//
+// Per-CPU energy performance preference (EPP) of intel_pstate/amd-pstate
+// drivers (/sys/devices/system/cpu/cpuN/cpufreq/energy_performance_preference).
+//
+// Preferences are represented by compact codes: index in
+// `available_preferences()` or -1 if the value is unknown (e.g. raw
+// numeric EPP value set by other tool). `apply()` re-reads current values
+// and skips CPUs which value equals to the requested one.
+//
+class cpu_epp
+{
+public:
+    using code_type = std::int8_t;
+
+public:
+    cpu_epp ();
+    explicit cpu_epp (std::string const & sysfs_root);
+    ~cpu_epp ();
+
+    // Enumerates CPUs with EPP support and opens attributes once.
+    void discover ();
+
+    size_t cpus_available () const;
+
+    // Returns logical CPU number for the index or -1.
+    int cpu_at (int index) const;
+
+    // Writable attributes usually require root privileges.
+    bool is_writable () const;
+
+    std::vector<std::string> available_preferences () const;
+    code_type code_of (std::string const & preference) const;
+    std::string preference_of (code_type code) const;
+
+    // Reads current preferences of all discovered CPUs into `codes`.
+    // Returns false if no CPU is available.
+    bool read (std::vector<code_type> & codes) const;
+
+    // Applies preference to all CPUs in one pass. Returns number of CPUs
+    // which preference was changed or -1 if preference is unknown.
+    int apply (std::string const & preference);
+
+    // Applies preferences per CPU (`codes` as returned by `read()`),
+    // unknown codes are skipped. Returns number of CPUs which preference
+    // was changed.
+    int apply (std::vector<code_type> const & codes);
+
+    // Reads current values of all discovered CPUs as is (preference names
+    // or raw numeric EPP values). Returns false if no CPU is available.
+    bool read_raw (std::vector<std::string> & values) const;
+
+    // Applies values per CPU (`values` as returned by `read_raw()`), empty
+    // values are skipped. Returns number of CPUs which value was changed.
+    int apply_raw (std::vector<std::string> const & values);
+
+private:
+    std::unique_ptr<details::cpu_epp> _d;
+};
+
+//
+// Applies preference to all CPUs for the scope lifetime and restores
+// previous per-CPU values on destruction.
+//
+class scoped_cpu_epp
+{
+public:
+    scoped_cpu_epp (cpu_epp & epp, std::string const & preference);
+    ~scoped_cpu_epp ();
+
+    scoped_cpu_epp (scoped_cpu_epp const &) = delete;
+    scoped_cpu_epp & operator = (scoped_cpu_epp const &) = delete;
+
+    bool is_active () const
+    {
+        return _active;
+    }
+
+private:
+    cpu_epp & _epp;
+    std::vector<std::string> _saved;
+    bool _active {false};
+};
+
+} // namespace pfs
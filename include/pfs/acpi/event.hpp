@@ -0,0 +1,74 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026 Vladislav Trifochkin
+//
+// This file is part of [pfs-acpi](https://github.com/semenovf/pfs-acpi) library.
+//
+// Changelog:
+//      2026.10.17 Initial version
+////////////////////////////////////////////////////////////////////////////////
+#pragma once
+#include "pfs/acpi.hpp"
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace pfs {
+
+struct acpi_event
+{
+    std::string device_class; // e.g. `battery`, `ac_adapter`, `thermal_zone`, `button/power`
+    std::string bus_id;       // e.g. `PNP0C0A:00`
+    std::uint32_t type;
+    std::uint32_t data;
+};
+
+//
+// Subscriber to ACPI events multicasted by the kernel on `acpi_event`
+// generic netlink family.
+//
+class acpi_event_listener
+{
+public:
+    acpi_event_listener ();
+    ~acpi_event_listener ();
+
+    acpi_event_listener (acpi_event_listener const &) = delete;
+    acpi_event_listener & operator = (acpi_event_listener const &) = delete;
+
+    // Resolves `acpi_event` family and joins its multicast group.
+    // Returns false if netlink socket can't be opened or family is not
+    // registered (kernel built without CONFIG_ACPI or family not loaded yet).
+    bool open ();
+    void close ();
+    bool is_open () const;
+
+    // File descriptor to poll for POLLIN.
+    int native_handle () const;
+
+    // Receives pending messages without blocking and appends parsed events
+    // to `events`. Returns number of events received or -1 on error.
+    int receive (std::vector<acpi_event> & events);
+
+    // Receives pending messages and applies targeted refresh for each event
+    // to `a`. Returns number of events processed or -1 on error.
+    int process (acpi & a);
+
+    // Parses netlink messages stored in `buf` and appends events of
+    // the family `family_id` to `events`. Returns number of events parsed.
+    static int parse (void const * buf, std::size_t len, int family_id
+        , std::vector<acpi_event> & events);
+
+    // Maps event to `acpi::device_enum` flags affected by it
+    // or `acpi::dev_none` if event does not concern any of acquired devices.
+    static int affected_devices (acpi_event const & ev);
+
+    // Refreshes devices affected by event.
+    static void apply (acpi_event const & ev, acpi & a);
+
+private:
+    int _fd {-1};
+    int _family_id {-1};
+};
+
+} // namespace pfs
@@ -0,0 +1,268 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026 Vladislav Trifochkin
+//
+// This file is part of [pfs-acpi](https://github.com/semenovf/pfs-acpi) library.
+//
+// Changelog:
+//      2026.10.17 Initial version
+////////////////////////////////////////////////////////////////////////////////
+#pragma once
+#include <cstddef>
+#include <cstring>
+#include <new>
+#include <string>
+#include <utility>
+
+namespace pfs {
+
+//
+// String with inline buffer of `N` bytes (including terminating nul).
+// Longer values are truncated.
+//
+template <std::size_t N>
+class fixed_string
+{
+public:
+    fixed_string ()
+    {
+        _data[0] = '\x0';
+    }
+
+    fixed_string (char const * s)
+    {
+        assign(s, std::strlen(s));
+    }
+
+    fixed_string & operator = (char const * s)
+    {
+        assign(s, std::strlen(s));
+        return *this;
+    }
+
+    fixed_string & operator = (std::string const & s)
+    {
+        assign(s.data(), s.size());
+        return *this;
+    }
+
+    void assign (char const * s, std::size_t n)
+    {
+        _size = n < N - 1 ? n : N - 1;
+        std::memmove(_data, s, _size);
+        _data[_size] = '\x0';
+    }
+
+    void clear ()
+    {
+        _size = 0;
+        _data[0] = '\x0';
+    }
+
+    char const * c_str () const
+    {
+        return _data;
+    }
+
+    char const * data () const
+    {
+        return _data;
+    }
+
+    std::size_t size () const
+    {
+        return _size;
+    }
+
+    bool empty () const
+    {
+        return _size == 0;
+    }
+
+    static constexpr std::size_t capacity ()
+    {
+        return N - 1;
+    }
+
+    int compare (char const * s) const
+    {
+        return std::strcmp(_data, s);
+    }
+
+    bool operator == (fixed_string const & other) const
+    {
+        return _size == other._size && std::memcmp(_data, other._data, _size) == 0;
+    }
+
+    bool operator != (fixed_string const & other) const
+    {
+        return !(*this == other);
+    }
+
+private:
+    std::size_t _size {0};
+    char _data[N];
+};
+
+//
+// Vector with inline storage for `N` elements. Elements appended to full
+// vector are dropped, so callers check `size() < max_size()` where it matters.
+//
+template <typename T, std::size_t N>
+class fixed_vector
+{
+public:
+    using value_type = T;
+    using iterator = T *;
+    using const_iterator = T const *;
+
+public:
+    fixed_vector () = default;
+
+    // For interface compatibility with allocator-aware containers
+    template <typename Allocator>
+    explicit fixed_vector (Allocator const &)
+    {}
+
+    fixed_vector (fixed_vector const & other)
+    {
+        for (auto const & x: other)
+            push_back(x);
+    }
+
+    fixed_vector (fixed_vector && other)
+    {
+        for (auto & x: other)
+            push_back(std::move(x));
+
+        other.clear();
+    }
+
+    ~fixed_vector ()
+    {
+        clear();
+    }
+
+    fixed_vector & operator = (fixed_vector const & other)
+    {
+        if (this != & other) {
+            clear();
+
+            for (auto const & x: other)
+                push_back(x);
+        }
+
+        return *this;
+    }
+
+    fixed_vector & operator = (fixed_vector && other)
+    {
+        if (this != & other) {
+            clear();
+
+            for (auto & x: other)
+                push_back(std::move(x));
+
+            other.clear();
+        }
+
+        return *this;
+    }
+
+    std::size_t size () const
+    {
+        return _size;
+    }
+
+    static constexpr std::size_t max_size ()
+    {
+        return N;
+    }
+
+    static constexpr std::size_t capacity ()
+    {
+        return N;
+    }
+
+    bool empty () const
+    {
+        return _size == 0;
+    }
+
+    void reserve (std::size_t)
+    {}
+
+    T * data ()
+    {
+        return reinterpret_cast<T *>(_storage);
+    }
+
+    T const * data () const
+    {
+        return reinterpret_cast<T const *>(_storage);
+    }
+
+    iterator begin () { return data(); }
+    iterator end () { return data() + _size; }
+    const_iterator begin () const { return data(); }
+    const_iterator end () const { return data() + _size; }
+
+    T & operator [] (std::size_t i) { return data()[i]; }
+    T const & operator [] (std::size_t i) const { return data()[i]; }
+
+    T & front () { return data()[0]; }
+    T const & front () const { return data()[0]; }
+    T & back () { return data()[_size - 1]; }
+    T const & back () const { return data()[_size - 1]; }
+
+    template <typename ...Args>
+    void emplace_back (Args &&... args)
+    {
+        if (_size < N) {
+            new (data() + _size) T(std::forward<Args>(args)...);
+            ++_size;
+        }
+    }
+
+    void push_back (T const & x)
+    {
+        emplace_back(x);
+    }
+
+    void push_back (T && x)
+    {
+        emplace_back(std::move(x));
+    }
+
+    void pop_back ()
+    {
+        data()[--_size].~T();
+    }
+
+    void clear ()
+    {
+        while (_size > 0)
+            pop_back();
+    }
+
+    // Count is truncated to `N`
+    void assign (std::size_t n, T const & value)
+    {
+        clear();
+
+        for (std::size_t i = 0; i < n && i < N; i++)
+            emplace_back(value);
+    }
+
+    void swap (fixed_vector & other)
+    {
+        fixed_vector tmp(std::move(other));
+        other = std::move(*this);
+        *this = std::move(tmp);
+    }
+
+private:
+    std::size_t _size {0};
+    alignas(T) unsigned char _storage[N * sizeof(T)];
+};
+
+} // namespace pfs
@@ -0,0 +1,90 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026 Vladislav Trifochkin
+//
+// This file is part of [pfs-acpi](https://github.com/semenovf/pfs-acpi) library.
+//
+// Changelog:
+//      2026.10.17 Initial version
+////////////////////////////////////////////////////////////////////////////////
+#pragma once
+#include "pfs/acpi.hpp"
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace pfs {
+
+struct emitter_options
+{
+    enum format_enum {
+          format_influx //!< InfluxDB line protocol (telegraf `socket_listener`, `influxdb_listener`)
+        , format_statsd //!< statsd gauges
+    };
+
+    format_enum format {format_influx};
+    std::string host {"127.0.0.1"};
+    int port {8089};
+
+    // Measurement name prefix: `<prefix>_battery` (line protocol) or
+    // `<prefix>.battery.<device>.<field>` (statsd)
+    std::string prefix {"acpi"};
+
+    // Extra tags for line protocol, e.g. `host=node1,rack=r2`
+    std::string tags;
+
+    // Records are packed into datagrams of at most this size,
+    // default fits into Ethernet MTU.
+    size_t max_datagram_size {1432};
+
+    // Batteries, AC adapters, thermal zones and fans are supported
+    int devices {acpi::dev_all};
+};
+
+struct emitter_stats
+{
+    std::uint64_t records;    // metric lines formatted
+    std::uint64_t datagrams;  // datagrams sent
+    std::uint64_t bytes;      // bytes sent
+    std::uint64_t send_calls; // sendmmsg() calls
+    std::uint64_t errors;     // failed sends
+};
+
+namespace details {
+class metrics_emitter;
+}
+
+//
+// Emitter of readings to local metrics collector (telegraf, statsd) over UDP.
+// Records are formatted into reusable buffer and sent by single sendmmsg()
+// call per `emit()`, many records per datagram.
+//
+// Measurements and fields (unavailable values are omitted):
+//      battery      percentage, seconds, rate, charge_state (integer value
+//                   of `charge_state_enum`)
+//      ac_adapter   online (0 or 1)
+//      thermal_zone temperature
+//      fan          cur_state, max_state
+//
+class metrics_emitter
+{
+public:
+    metrics_emitter ();
+    ~metrics_emitter ();
+
+    // Resolves collector address and creates socket.
+    bool open (emitter_options const & options);
+    void close ();
+
+    bool is_open () const;
+
+    // Formats last acquired readings and sends them. Returns number of
+    // records sent or -1 on error.
+    int emit (acpi const & a);
+
+    emitter_stats stats () const;
+
+private:
+    std::unique_ptr<details::metrics_emitter> _d;
+};
+
+} // namespace pfs
@@ -0,0 +1,63 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026 Vladislav Trifochkin
+//
+// This file is part of [pfs-acpi](https://github.com/semenovf/pfs-acpi) library.
+//
+// Changelog:
+//      2026.10.17 Initial version
+////////////////////////////////////////////////////////////////////////////////
+#pragma once
+#include "pfs/acpi/monitor_protocol.hpp"
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace pfs {
+
+namespace details {
+class acpi_monitor_client;
+}
+
+//
+// Client of the monitoring daemon (`pfs-acpid`). Keeps the last known value
+// of each subscribed field updated by deltas pushed by the daemon.
+//
+class acpi_monitor_client
+{
+public:
+    acpi_monitor_client ();
+    ~acpi_monitor_client ();
+
+    bool connect (std::string const & socket_path = monitor::DEFAULT_SOCKET_PATH);
+    void close ();
+    bool is_open () const;
+
+    // File descriptor to poll for POLLIN.
+    int native_handle () const;
+
+    // Subscribes to fields (see `monitor::field_bit()`, `monitor::fields_of()`)
+    // with minimal interval between updates. Replaces previous subscription.
+    bool subscribe (std::uint32_t fields, std::uint32_t interval_ms);
+
+    // Waits up to `timeout_ms` (-1 infinitely) for message from the daemon
+    // and applies it. Returns type of the message (`monitor::msg_names` or
+    // `monitor::msg_delta`), 0 on timeout or -1 on error or disconnection.
+    int receive (int timeout_ms);
+
+    // Entries of the last delta message
+    std::vector<monitor::delta_entry> const & changes () const;
+
+    std::uint64_t generation () const;
+
+    size_t devices_count (monitor::device_class_enum device_class) const;
+    std::string device_name (monitor::device_class_enum device_class, int index) const;
+
+    // Last known value or `monitor::VALUE_UNAVAILABLE`
+    std::int32_t value (monitor::field_enum field, int index) const;
+
+private:
+    std::unique_ptr<details::acpi_monitor_client> _d;
+};
+
+} // namespace pfs
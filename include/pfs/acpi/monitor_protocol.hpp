@@ -0,0 +1,141 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026 Vladislav Trifochkin
+//
+// This file is part of [pfs-acpi](https://github.com/semenovf/pfs-acpi) library.
+//
+// Changelog:
+//      2026.10.17 Initial version
+////////////////////////////////////////////////////////////////////////////////
+#pragma once
+#include "pfs/acpi.hpp"
+#include <climits>
+#include <cstdint>
+
+//
+// Protocol of the monitoring daemon (`pfs-acpid`).
+//
+// Messages are exchanged over Unix domain socket of SOCK_SEQPACKET type
+// (one message per packet) in native byte order:
+//
+//      client -> daemon: subscribe_request
+//      daemon -> client: names message (message_header + name_entry[count]),
+//                        sent after subscription and whenever set of devices
+//                        changes, followed by delta message with all
+//                        subscribed values;
+//                        delta message (delta_header + delta_entry[count])
+//                        with values changed since the previous delta, sent
+//                        not more often than subscribed interval, or
+//                        immediately on ACPI event.
+//
+namespace pfs {
+namespace monitor {
+
+constexpr std::uint16_t PROTOCOL_VERSION = 1;
+constexpr char const * DEFAULT_SOCKET_PATH = "/run/pfs-acpid.sock";
+constexpr std::int32_t VALUE_UNAVAILABLE = INT32_MIN;
+
+enum message_enum: std::uint16_t {
+      msg_subscribe = 1
+    , msg_names
+    , msg_delta
+};
+
+enum device_class_enum: std::uint8_t {
+      class_battery
+    , class_ac_adapter
+    , class_thermal_zone
+    , class_fan
+    , class_count
+};
+
+enum field_enum: std::uint8_t {
+      field_battery_percentage   //!< percents
+    , field_battery_seconds      //!< seconds until charged or remaining
+    , field_battery_rate         //!< mA (or mW if voltage is unavailable)
+    , field_battery_charge_state //!< `charge_state_enum`
+    , field_ac_online            //!< 0 or 1
+    , field_temperature          //!< millidegrees Celsius
+    , field_fan_cur_state
+    , field_fan_max_state
+    , field_count
+};
+
+constexpr std::uint32_t ALL_FIELDS = (1u << field_count) - 1;
+
+inline constexpr std::uint32_t field_bit (field_enum field)
+{
+    return 1u << field;
+}
+
+inline constexpr device_class_enum class_of (field_enum field)
+{
+    return field <= field_battery_charge_state ? class_battery
+        : field == field_ac_online ? class_ac_adapter
+        : field == field_temperature ? class_thermal_zone
+        : class_fan;
+}
+
+// Maps `acpi::device_enum` flags to bits of all fields of these devices
+inline std::uint32_t fields_of (int devices)
+{
+    std::uint32_t result = 0;
+
+    if (devices & acpi::dev_battery)
+        result |= field_bit(field_battery_percentage) | field_bit(field_battery_seconds)
+            | field_bit(field_battery_rate) | field_bit(field_battery_charge_state);
+
+    if (devices & acpi::dev_ac_adapter)
+        result |= field_bit(field_ac_online);
+
+    if (devices & acpi::dev_thermal_zone)
+        result |= field_bit(field_temperature);
+
+    if (devices & acpi::dev_fan)
+        result |= field_bit(field_fan_cur_state) | field_bit(field_fan_max_state);
+
+    return result;
+}
+
+struct message_header
+{
+    std::uint16_t type;    // message_enum
+    std::uint16_t version; // PROTOCOL_VERSION
+    std::uint32_t count;   // number of entries following the message header
+};
+
+struct subscribe_request
+{
+    message_header header;     // count = 0
+    std::uint32_t fields;      // field bits
+    std::uint32_t interval_ms; // minimal interval between deltas
+};
+
+struct name_entry
+{
+    std::uint8_t device_class; // device_class_enum
+    std::uint8_t reserved;
+    std::uint16_t index;
+    char name[28];             // nul-terminated, truncated if longer
+};
+
+struct delta_header
+{
+    message_header header;
+    std::uint64_t generation;  // see `acpi::generation()`
+    std::int64_t timestamp_ns; // CLOCK_REALTIME
+};
+
+struct delta_entry
+{
+    std::uint8_t field;        // field_enum
+    std::uint8_t reserved;
+    std::uint16_t index;       // device index within class
+    std::int32_t value;        // or VALUE_UNAVAILABLE
+};
+
+static_assert(sizeof(subscribe_request) == 16, "unexpected subscribe_request size");
+static_assert(sizeof(name_entry) == 32, "unexpected name_entry size");
+static_assert(sizeof(delta_header) == 24, "unexpected delta_header size");
+static_assert(sizeof(delta_entry) == 8, "unexpected delta_entry size");
+
+}} // namespace pfs::monitor
@@ -0,0 +1,82 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026 Vladislav Trifochkin
+//
+// This file is part of [pfs-acpi](https://github.com/semenovf/pfs-acpi) library.
+//
+// Changelog:
+//      2026.10.17 Initial version
+////////////////////////////////////////////////////////////////////////////////
+#pragma once
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace pfs {
+
+namespace details {
+class platform_profile;
+}
+
+//
+// ACPI platform profile (/sys/firmware/acpi/platform_profile), e.g.
+// `low-power`, `balanced`, `performance`.
+//
+class platform_profile
+{
+public:
+    platform_profile ();
+    explicit platform_profile (std::string const & sysfs_root);
+    ~platform_profile ();
+
+    bool is_supported () const;
+
+    // Profiles supported by firmware (read once at construction).
+    std::vector<std::string> choices () const;
+    bool has_choice (std::string const & profile) const;
+
+    // Returns cached current profile.
+    std::string current () const;
+
+    // Re-reads current profile. Returns true if profile has changed since
+    // last read.
+    bool refresh ();
+
+    // File descriptor to poll for POLLPRI to be notified about profile
+    // changes (kernel calls sysfs_notify() on switch). Call `refresh()`
+    // after wake up to re-arm notification.
+    int native_handle () const;
+
+    // Switches profile. Returns false if profile is not in choices or
+    // attribute is not writable (usually requires root privileges).
+    bool set (std::string const & profile);
+
+private:
+    std::unique_ptr<details::platform_profile> _d;
+};
+
+//
+// Switches platform profile for the scope lifetime and restores
+// the previous one on destruction.
+//
+class scoped_platform_profile
+{
+public:
+    scoped_platform_profile (platform_profile & pp, std::string const & profile);
+    ~scoped_platform_profile ();
+
+    scoped_platform_profile (scoped_platform_profile const &) = delete;
+    scoped_platform_profile & operator = (scoped_platform_profile const &) = delete;
+
+    // Returns true if profile was switched and will be restored on destruction.
+    bool is_active () const
+    {
+        return _active;
+    }
+
+private:
+    platform_profile & _pp;
+    std::string _saved;
+    bool _active {false};
+};
+
+} // namespace pfs
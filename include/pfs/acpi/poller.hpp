@@ -0,0 +1,112 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026 Vladislav Trifochkin
+//
+// This file is part of [pfs-acpi](https://github.com/semenovf/pfs-acpi) library.
+//
+// Changelog:
+//      2026.10.17 Initial version
+//      2026.10.17 Added low-power mode
+////////////////////////////////////////////////////////////////////////////////
+#pragma once
+#include "pfs/acpi.hpp"
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace pfs {
+
+struct poller_options
+{
+    struct class_interval
+    {
+        int devices;
+        int interval_ms;
+    };
+
+    enum sched_enum {
+          sched_other //!< SCHED_OTHER with `nice` value
+        , sched_idle  //!< SCHED_IDLE, runs only when CPU is idle otherwise
+    };
+
+    int interval_ms {1000};
+    int devices {acpi::dev_all};
+
+    // Devices are acquired once when polling starts, then each wakeup
+    // calls `acpi::refresh()` if true or `acpi::acquire()` otherwise.
+    bool refresh {true};
+
+    // CPUs the polling thread is allowed to run on (e.g. housekeeping cores),
+    // empty to inherit affinity of the process.
+    std::vector<int> cpus;
+
+    sched_enum sched {sched_other};
+    int nice {0}; // for sched_other
+
+    // Timer slack of the polling thread in nanoseconds (PR_SET_TIMERSLACK),
+    // larger values let kernel coalesce wakeups, -1 to keep default (50 us).
+    long timer_slack_ns {-1};
+
+    // Per-class polling intervals, e.g. `{{acpi::dev_thermal, 2000},
+    // {acpi::dev_power_supply, 30000}}`. If empty, `devices` are polled every
+    // `interval_ms`. Classes due at the same time are updated by single wakeup.
+    std::vector<class_interval> class_intervals;
+
+    // Low-power mode: deadlines are rounded up to multiple of `grid_ms`
+    // (CLOCK_MONOTONIC), so timers of all classes (and of other processes
+    // using the same grid) fire together, and intervals are multiplied by
+    // `battery_interval_factor` while all AC adapters are off-line.
+    bool low_power {false};
+    int grid_ms {1000};
+    int battery_interval_factor {4};
+
+    // Wakeups budget, 0 is unlimited. Wakeups are postponed (and due classes
+    // merged) to keep at most `wakeups_per_minute` wakeups per minute.
+    int wakeups_per_minute {0};
+};
+
+struct poller_stats
+{
+    std::uint64_t wakeups;
+    double wakeups_per_second; // average since start
+    long long cpu_time_ns;     // CPU time consumed by the polling thread
+    int last_cpu;              // CPU the thread ran on last time or -1
+    std::uint64_t cpus_mask;   // bit per CPU (0-63) the thread ran on
+    double wakeups_per_minute; // average since start
+    std::uint64_t class_updates; // number of class updates, exceeds `wakeups` if merged
+    bool on_battery;           // all AC adapters are off-line (low-power mode only)
+};
+
+namespace details {
+class acpi_poller;
+}
+
+//
+// Library-owned polling thread. Callback is called from the polling thread
+// after each update, `acpi` instance must not be accessed from other
+// threads while polling is running.
+//
+class acpi_poller
+{
+public:
+    using callback_type = std::function<void (acpi const &)>;
+
+public:
+    acpi_poller ();
+    ~acpi_poller ();
+
+    // Starts polling thread, returns false if it's already running or
+    // options can't be applied to the thread (e.g. no permission for
+    // negative nice value or CPU is not available).
+    bool start (acpi & a, poller_options const & options, callback_type callback);
+
+    void stop ();
+    bool is_running () const;
+
+    poller_stats stats () const;
+
+private:
+    std::unique_ptr<details::acpi_poller> _d;
+};
+
+} // namespace pfs
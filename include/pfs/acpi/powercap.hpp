@@ -0,0 +1,109 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026 Vladislav Trifochkin
+//
+// This file is part of [pfs-acpi](https://github.com/semenovf/pfs-acpi) library.
+//
+// Changelog:
+//      2026.10.17 Initial version
+//      2026.10.17 Added `refresh_constraint()`
+////////////////////////////////////////////////////////////////////////////////
+#pragma once
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace pfs {
+
+// Power limit constraint of the power domain (e.g. PL1/PL2 of RAPL package)
+struct power_constraint
+{
+    std::string name;         // e.g. `long_term`, `short_term`, `peak_power`
+    long long power_limit_uw; // or -1 if unavailable
+    long long time_window_us; // or -1 if unavailable
+    long long max_power_uw;   // or -1 if unavailable
+};
+
+struct power_domain
+{
+    std::string name;   // powercap zone, e.g. `intel-rapl:0`, `intel-rapl:0:1`
+    std::string domain; // e.g. `package-0`, `core`, `dram`, `psys`
+    bool enabled;
+    long long energy_uj;           // energy counter or -1 if unavailable
+    long long max_energy_range_uj; // energy counter wraps around at this value
+    long long power_uw;            // average power since previous refresh or -1 if unavailable
+    std::vector<power_constraint> constraints;
+};
+
+namespace details {
+class powercap;
+}
+
+//
+// Power domains of powercap framework (/sys/class/powercap), e.g. RAPL.
+//
+class powercap
+{
+public:
+    powercap ();
+    explicit powercap (std::string const & sysfs_root);
+    ~powercap ();
+
+    // Enumerates power zones and opens attributes once.
+    void discover ();
+
+    // Re-reads energy counters and constraints using cached file descriptors.
+    void refresh ();
+
+    // Re-reads power limit and time window of the constraint only, energy
+    // counters and power baseline are left intact. Returns false if there
+    // is no such constraint.
+    bool refresh_constraint (int domain_index, int constraint_index);
+
+    size_t domains_available () const;
+    power_domain domain_at (int index) const;
+
+    // Returns index of the domain by zone name (`intel-rapl:0`) or domain
+    // name (`package-0`) or -1 if not found.
+    int find_domain (std::string const & name) const;
+
+    // Returns index of the constraint by name (`long_term`) or -1 if not found.
+    int find_constraint (int domain_index, std::string const & name) const;
+
+    // Writable attributes usually require root privileges.
+    bool set_power_limit (int domain_index, int constraint_index, long long power_limit_uw);
+    bool set_time_window (int domain_index, int constraint_index, long long time_window_us);
+
+private:
+    std::unique_ptr<details::powercap> _d;
+};
+
+//
+// Overrides power limit (and optionally time window) of the constraint
+// for the scope lifetime and restores previous values on destruction.
+//
+class scoped_power_limit
+{
+public:
+    scoped_power_limit (powercap & pc, int domain_index, int constraint_index
+        , long long power_limit_uw, long long time_window_us = -1);
+    ~scoped_power_limit ();
+
+    scoped_power_limit (scoped_power_limit const &) = delete;
+    scoped_power_limit & operator = (scoped_power_limit const &) = delete;
+
+    bool is_active () const
+    {
+        return _power_limit_changed || _time_window_changed;
+    }
+
+private:
+    powercap & _pc;
+    int _domain_index;
+    int _constraint_index;
+    long long _saved_power_limit_uw {-1};
+    long long _saved_time_window_us {-1};
+    bool _power_limit_changed {false};
+    bool _time_window_changed {false};
+};
+
+} // namespace pfs
@@ -0,0 +1,82 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026 Vladislav Trifochkin
+//
+// This file is part of [pfs-acpi](https://github.com/semenovf/pfs-acpi) library.
+//
+// Changelog:
+//      2026.10.17 Initial version
+////////////////////////////////////////////////////////////////////////////////
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace pfs {
+
+//
+// Log-bucketed (HDR style) histogram of read latencies in nanoseconds.
+// Each power of two range is split into 8 linear sub-buckets, so recorded
+// values are accurate within 12.5%. Values above ~18 minutes fall into
+// the last bucket.
+//
+struct latency_histogram
+{
+    static constexpr int SUB_BUCKET_BITS = 3;
+    static constexpr int SUB_BUCKETS = 1 << SUB_BUCKET_BITS;
+    static constexpr int MAX_EXPONENT = 40;
+    static constexpr int BUCKETS = SUB_BUCKETS * (MAX_EXPONENT - SUB_BUCKET_BITS + 1);
+
+    std::uint64_t counts[BUCKETS];
+    std::uint64_t count;  // sum of counts
+    std::uint64_t sum_ns;
+    std::uint64_t max_ns;
+
+    static int bucket_of (std::uint64_t ns);
+
+    // Range of values counted by bucket (both ends inclusive)
+    static std::uint64_t bucket_lower (int bucket);
+    static std::uint64_t bucket_upper (int bucket);
+
+    // Returns upper bound of the bucket containing `percent` percentile
+    // (limited by maximum value) or 0 if histogram is empty.
+    std::uint64_t percentile (double percent) const;
+
+    double mean_ns () const;
+
+    void merge (latency_histogram const & other);
+};
+
+struct attribute_latency
+{
+    std::string path;
+    int device; // `acpi::device_enum` value or `acpi::dev_none` for attributes of other classes
+    latency_histogram histogram;
+};
+
+//
+// Latencies of attribute reads through cached file descriptors
+// (`acpi::refresh()`, sampler and other classes re-reading attributes).
+// Recording takes two clock reads and a few relaxed atomic increments
+// per read, no locks.
+//
+// Attributes opened (devices acquired) while recording is enabled are
+// tracked. Histograms are kept by path, so they survive re-acquisition.
+//
+class read_latency
+{
+public:
+    static void enable (bool on = true);
+    static bool is_enabled ();
+
+    // Histograms of all tracked attributes in order of first opening
+    static std::vector<attribute_latency> snapshot ();
+
+    // Merged histogram of attributes of devices specified by `devices`
+    // flags (`acpi::device_enum`)
+    static latency_histogram snapshot (int devices);
+
+    // Clears histograms, tracked attributes are kept
+    static void reset ();
+};
+
+} // namespace pfs
@@ -0,0 +1,68 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026 Vladislav Trifochkin
+//
+// This file is part of [pfs-acpi](https://github.com/semenovf/pfs-acpi) library.
+//
+// Changelog:
+//      2026.10.17 Initial version
+////////////////////////////////////////////////////////////////////////////////
+#pragma once
+#include <climits>
+#include <memory>
+#include <string>
+
+namespace pfs {
+
+namespace details {
+class realtime_reader;
+}
+
+//
+// Read path for realtime control loops (e.g. SCHED_FIFO thread reading a few
+// temperatures and a power counter each cycle). Everything is prepared during
+// setup, so each cycle does only pread() per attribute into a buffer on the
+// stack: no allocation, locking or path building.
+//
+// Setup sequence:
+//      1. add_attribute() for each attribute;
+//      2. lock_memory() (optional, recommended) to avoid page faults;
+//      3. prepare() from the realtime thread.
+//
+class realtime_reader
+{
+public:
+    static constexpr long long INVALID_VALUE = LLONG_MIN;
+
+public:
+    realtime_reader ();
+    ~realtime_reader ();
+
+    // Opens attribute. Returns attribute index or -1 on error.
+    int add_attribute (std::string const & path);
+    size_t attributes_count () const;
+
+    // Reads every attribute once to warm up kernel paths and prefaults
+    // `stack_size` bytes of the calling thread stack. Returns false if any
+    // attribute can't be read.
+    bool prepare (size_t stack_size = 64 * 1024);
+
+    // Locks current and future pages of the process in memory
+    // (mlockall(MCL_CURRENT | MCL_FUTURE)) and disables heap trimming and
+    // mmap() allocations, so memory freed by other threads doesn't return
+    // to the kernel and fault again. Requires CAP_IPC_LOCK or sufficient
+    // RLIMIT_MEMLOCK. Returns false if memory can't be locked.
+    static bool lock_memory ();
+
+    // Reads all attributes into `values` array of `attributes_count()`
+    // elements. Value of unreadable attribute is set to `INVALID_VALUE`.
+    // Returns number of attributes read successfully.
+    size_t read (long long * values) const;
+
+    // Reads single attribute, returns `INVALID_VALUE` on error.
+    long long read (int attribute) const;
+
+private:
+    std::unique_ptr<details::realtime_reader> _d;
+};
+
+} // namespace pfs
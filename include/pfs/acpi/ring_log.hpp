@@ -0,0 +1,95 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026 Vladislav Trifochkin
+//
+// This file is part of [pfs-acpi](https://github.com/semenovf/pfs-acpi) library.
+//
+// Changelog:
+//      2026.10.17 Initial version
+////////////////////////////////////////////////////////////////////////////////
+#pragma once
+#include "pfs/acpi.hpp"
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace pfs {
+
+namespace details {
+class ring_log;
+}
+
+//
+// Fixed layout record of the ring log. Sensor values missing in the sample
+// (e.g. removed battery) are NaN.
+//
+struct ring_log_record
+{
+    static constexpr std::size_t MAX_SENSORS = 32;
+
+    std::uint64_t seq;          // sequence number, starts from 0
+    std::int64_t timestamp_ns;  // CLOCK_REALTIME, survives reboot
+    std::uint32_t sensors;      // number of valid elements in `values`
+    std::uint32_t checksum;     // CRC-32 of the record with this field zeroed
+    float values[MAX_SENSORS];
+};
+
+//
+// Persistent ring of sample records in a memory-mapped file of fixed size
+// (header + capacity * sizeof(ring_log_record)), so history survives process
+// crash and, as far as the page cache is written back (e.g. orderly thermal
+// shutdown or `flush()`), reboot.
+//
+// Append is lock-free and wait-free: slot is reserved by atomic increment of
+// the sequence number in the header and the record is copied into the
+// mapping, there are no syscalls. Torn records (crash during append) are
+// detected by checksum and skipped by reader.
+//
+// Sensor columns for `append(acpi const &)` are the same as in
+// `sample_recorder`: thermal zones temperatures, batteries rates, fan states.
+//
+class ring_log
+{
+public:
+    ring_log ();
+    ~ring_log ();
+
+    // Opens log file for appending, creates it if not exists. Existing log with
+    // the same capacity and sensors is continued, otherwise it is
+    // reinitialized. Names longer than 31 characters are truncated, sensors
+    // above `ring_log_record::MAX_SENSORS` are ignored.
+    bool open (std::string const & path
+        , size_t capacity
+        , std::vector<std::string> const & sensor_names);
+
+    // Opens existing log file read-only.
+    bool open (std::string const & path);
+
+    void close ();
+
+    bool is_open () const;
+    size_t capacity () const;
+    std::vector<std::string> sensor_names () const;
+
+    // Appends record of `count` values, returns false if log is not open
+    // for appending.
+    bool append (float const * values, size_t count, std::int64_t timestamp_ns);
+
+    // Appends last acquired readings with current time.
+    bool append (acpi const & a);
+
+    // Starts write-back of dirty pages (msync()), waits for completion if
+    // `wait` is true.
+    bool flush (bool wait = false);
+
+    // Copies valid records ordered by sequence number.
+    std::vector<ring_log_record> records () const;
+
+    // Sensor names of `append(acpi const &)` in form `<class>:<device>`.
+    static std::vector<std::string> acpi_sensor_names (acpi const & a);
+
+private:
+    std::unique_ptr<details::ring_log> _d;
+};
+
+} // namespace pfs
@@ -0,0 +1,108 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026 Vladislav Trifochkin
+//
+// This file is part of [pfs-acpi](https://github.com/semenovf/pfs-acpi) library.
+//
+// Changelog:
+//      2026.10.17 Initial version
+////////////////////////////////////////////////////////////////////////////////
+#pragma once
+#include "pfs/acpi.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace pfs {
+
+//
+// Recorder of timestamped readings (thermal zone temperatures, battery rates
+// and fan states) with resampling onto a common timeline.
+//
+// Sensors (columns) are fixed by the first recorded acquisition in order:
+// thermal zones, batteries, fans. Records are kept in a ring of `capacity`
+// records.
+//
+class sample_recorder
+{
+public:
+    enum interpolation_enum {
+          interpolation_linear
+        , interpolation_last_value
+    };
+
+    enum layout_enum {
+          layout_row_major    //!< out[row * sensors + sensor]
+        , layout_column_major //!< out[sensor * rows + row]
+    };
+
+public:
+    explicit sample_recorder (size_t capacity);
+
+    // Records last acquired readings with current CLOCK_MONOTONIC
+    // (steady clock) timestamp.
+    void record (acpi const & a);
+
+    // Records readings with specified timestamp in nanoseconds. Timestamps
+    // must not decrease, otherwise record is ignored.
+    void record (acpi const & a, std::int64_t timestamp_ns);
+
+    void clear ();
+
+    size_t sensors () const
+    {
+        return _names.size();
+    }
+
+    // Sensor names in form `<class>:<device>`, e.g. `temperature:thermal_zone0`,
+    // `battery_rate:BAT0`, `fan_state:cooling_device0`.
+    std::vector<std::string> const & sensor_names () const
+    {
+        return _names;
+    }
+
+    size_t size () const
+    {
+        return _size;
+    }
+
+    size_t capacity () const
+    {
+        return _capacity;
+    }
+
+    std::int64_t first_timestamp () const;
+    std::int64_t last_timestamp () const;
+
+    // Resamples recorded readings onto timeline `start_ns + i * step_ns`
+    // (i < rows) into caller buffer of `rows * sensors()` elements.
+    // Points before the first record are NaN, points after the last record
+    // hold the last value. Complexity is O(records + rows * sensors).
+    // Returns number of rows written.
+    size_t resample (std::int64_t start_ns
+        , std::int64_t step_ns
+        , size_t rows
+        , interpolation_enum interpolation
+        , layout_enum layout
+        , float * out) const;
+
+private:
+    size_t slot (size_t index) const
+    {
+        return (_head + _capacity - _size + index) % _capacity;
+    }
+
+private:
+    size_t _capacity;
+    size_t _size {0};
+    size_t _head {0};
+    size_t _thermal_zones {0};
+    size_t _batteries {0};
+    size_t _fans {0};
+    std::vector<std::string> _names;
+    std::vector<std::int64_t> _timestamps; // capacity
+    std::vector<float> _values;            // capacity x sensors
+    std::vector<int> _scratch;
+};
+
+} // namespace pfs
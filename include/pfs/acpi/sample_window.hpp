@@ -0,0 +1,100 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026 Vladislav Trifochkin
+//
+// This file is part of [pfs-acpi](https://github.com/semenovf/pfs-acpi) library.
+//
+// Changelog:
+//      2026.10.17 Initial version
+////////////////////////////////////////////////////////////////////////////////
+#pragma once
+#include <cstddef>
+#include <vector>
+
+namespace pfs {
+
+struct window_stats
+{
+    size_t samples;
+    float mean;
+    float min;
+    float max;
+    float stddev;
+};
+
+//
+// Window of the last N samples per sensor (e.g. thermal zone temperatures,
+// battery rates). Samples of each sensor are stored contiguously, so
+// statistics are computed by vectorized reduction kernels (SSE2/AVX2,
+// chosen at runtime, with scalar fallback).
+//
+class sample_window
+{
+public:
+    enum simd_enum {
+          simd_auto   //!< the best available instruction set detected at runtime
+        , simd_scalar
+        , simd_sse2
+        , simd_avx2
+    };
+
+public:
+    sample_window (size_t sensors, size_t capacity);
+
+    size_t sensors () const
+    {
+        return _sensors;
+    }
+
+    size_t capacity () const
+    {
+        return _capacity;
+    }
+
+    // Number of samples stored per sensor (up to capacity)
+    size_t size () const
+    {
+        return _size;
+    }
+
+    void clear ()
+    {
+        _size = 0;
+        _head = 0;
+    }
+
+    // Appends one sample for each sensor, the oldest samples are
+    // overwritten when window is full.
+    void append (float const * values);
+
+    window_stats stats (size_t sensor) const;
+
+    // Calculates statistics for all sensors into `out` array of `sensors()`
+    // elements.
+    void stats (window_stats * out) const;
+
+    // Returns percentile `p` (from 0 to 100) of sensor samples
+    // (nearest-rank method).
+    float percentile (size_t sensor, float p) const;
+
+    // Selects kernels, returns false if instruction set is not supported
+    // by CPU (selection is not changed in that case).
+    bool set_simd (simd_enum simd);
+
+    simd_enum simd () const
+    {
+        return _simd;
+    }
+
+    static simd_enum detected_simd ();
+
+private:
+    size_t _sensors;
+    size_t _capacity;
+    size_t _size {0};
+    size_t _head {0};
+    simd_enum _simd;
+    std::vector<float> _data; // sensors x capacity
+    mutable std::vector<float> _scratch;
+};
+
+} // namespace pfs
@@ -0,0 +1,55 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026 Vladislav Trifochkin
+//
+// This file is part of [pfs-acpi](https://github.com/semenovf/pfs-acpi) library.
+//
+// Changelog:
+//      2026.10.17 Initial version
+////////////////////////////////////////////////////////////////////////////////
+#pragma once
+#include <cstddef>
+#include <string>
+
+namespace pfs {
+
+//
+// Record and replay of sysfs reads made by the library (all `acpi` instances
+// and other sysfs based classes of the process).
+//
+// Recording captures every path read (files, cached attributes, directory
+// listings and links) with the sequence of values read, so trace of a few
+// `acquire()`/`refresh()` runs on a production machine can be saved into
+// compact file (consecutive equal values are stored once). Replay serves
+// reads from memory: values of each path are returned in recorded order
+// and cyclically, paths absent in the trace can't be read.
+//
+// Instances must acquire devices after recording or replay is started,
+// attributes opened before are not traced. Writes are not traced.
+//
+class sysfs_trace
+{
+public:
+    static void record ();
+    static void replay ();
+
+    // Stops recording or replay, the trace is kept
+    static void stop ();
+
+    static bool is_recording ();
+    static bool is_replaying ();
+
+    // Clears the trace and restarts replay from the beginning
+    static void clear ();
+    static void rewind ();
+
+    static bool save (std::string const & path);
+
+    // Loads trace from file replacing the current one
+    static bool load (std::string const & path);
+
+    static std::size_t paths ();  // number of paths in the trace
+    static std::size_t reads ();  // number of recorded or replayed reads
+    static std::size_t misses (); // replayed reads of paths absent in the trace
+};
+
+} // namespace pfs
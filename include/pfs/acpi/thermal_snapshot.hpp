@@ -0,0 +1,89 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026 Vladislav Trifochkin
+//
+// This file is part of [pfs-acpi](https://github.com/semenovf/pfs-acpi) library.
+//
+// Changelog:
+//      2026.10.17 Initial version
+////////////////////////////////////////////////////////////////////////////////
+#pragma once
+#include "pfs/acpi.hpp"
+#include <cstddef>
+#include <cstdint>
+
+namespace pfs {
+
+//
+// Structure-of-arrays snapshot of thermal zones temperatures with
+// compile-time capacity. Snapshot is trivially copyable, so it can be
+// copied between buffers with memcpy(). Zone names are kept separately
+// (see `acpi::thermal_zone_names()`), index in snapshot equals to zone index.
+//
+// Temperatures of invalid (unavailable) zones are stored as `INVALID`, so
+// reductions are plain loops over contiguous array without branches.
+//
+template <std::size_t MaxZones>
+struct thermal_snapshot
+{
+    static constexpr std::size_t CAPACITY = MaxZones;
+    static constexpr std::size_t VALID_WORDS = (MaxZones + 63) / 64;
+    static constexpr std::int32_t INVALID = INT32_MIN;
+
+    std::size_t count;
+    std::int32_t millidegrees[MaxZones];
+    std::int64_t timestamp_ns[MaxZones]; // CLOCK_MONOTONIC time of acquisition
+    std::uint64_t valid[VALID_WORDS];
+
+    // Fills snapshot with last acquired thermal zones data.
+    void assign (acpi const & a)
+    {
+        count = a.thermal_zones_soa(millidegrees, timestamp_ns, valid, MaxZones);
+    }
+
+    bool is_valid (std::size_t index) const
+    {
+        return index < count && (valid[index / 64] & (std::uint64_t{1} << (index % 64)));
+    }
+
+    float temperature (std::size_t index) const
+    {
+        return is_valid(index) ? millidegrees[index] / float{1000.0} : float{-1};
+    }
+
+    // Returns the maximum temperature in millidegrees Celsius or `INVALID`
+    // if there are no valid zones.
+    std::int32_t max_millidegrees () const
+    {
+        std::int32_t result = INVALID;
+
+        for (std::size_t i = 0; i < count; i++)
+            result = millidegrees[i] > result ? millidegrees[i] : result;
+
+        return result;
+    }
+
+    bool any_over (std::int32_t threshold_millidegrees) const
+    {
+        int result = 0;
+
+        for (std::size_t i = 0; i < count; i++)
+            result |= millidegrees[i] > threshold_millidegrees;
+
+        return result != 0;
+    }
+
+    std::size_t count_over (std::int32_t threshold_millidegrees) const
+    {
+        std::size_t result = 0;
+
+        for (std::size_t i = 0; i < count; i++)
+            result += millidegrees[i] > threshold_millidegrees;
+
+        return result;
+    }
+};
+
+template <std::size_t MaxZones>
+constexpr std::int32_t thermal_snapshot<MaxZones>::INVALID;
+
+} // namespace pfs
@@ -0,0 +1,215 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026 Vladislav Trifochkin
+//
+// This file is part of [pfs-acpi](https://github.com/semenovf/pfs-acpi) library.
+//
+// Changelog:
+//      2026.10.17 Initial version
+////////////////////////////////////////////////////////////////////////////////
+#include "pfs/acpi/devices.hpp"
+#include "sysfs.hpp"
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <strings.h>
+
+namespace pfs {
+
+static char const * ACPI_DEVICES_PATH = "/bus/acpi/devices";
+
+namespace details {
+
+struct acpi_device_extended : acpi_device
+{
+    sysfs_attribute power_state_attr;
+    sysfs_attribute real_power_state_attr;
+};
+
+class acpi_devices
+{
+public:
+    acpi_devices (std::string const & sysfs_root)
+        : _root_dir(sysfs_root + ACPI_DEVICES_PATH)
+    {}
+
+    void discover ();
+    void refresh ();
+
+    size_t devices_available () const
+    {
+        return _devices.size();
+    }
+
+    acpi_device device_at (int index) const
+    {
+        if (index >= 0 && index < _devices.size()) {
+            return _devices[index];
+        }
+        return acpi_device{};
+    }
+
+    int find_by_path (std::string const & path) const
+    {
+        auto pos = _path_index.find(path);
+        return pos != _path_index.end() ? pos->second : -1;
+    }
+
+    std::vector<int> find_by_hid (std::string const & hid) const
+    {
+        std::vector<int> result;
+        auto range = _hid_index.equal_range(hid);
+
+        for (auto pos = range.first; pos != range.second; ++pos)
+            result.push_back(pos->second);
+
+        return result;
+    }
+
+    std::vector<int> find_by_power_state (power_state_enum state) const
+    {
+        std::vector<int> result;
+
+        for (int i = 0; i < _devices.size(); i++) {
+            if (_devices[i].power_state == state)
+                result.push_back(i);
+        }
+
+        return result;
+    }
+
+private:
+    std::string _root_dir;
+    std::vector<acpi_device_extended> _devices;
+    std::unordered_map<std::string, int> _path_index;
+    std::unordered_multimap<std::string, int> _hid_index;
+};
+
+static power_state_enum parse_power_state (char const * s)
+{
+    if (strcasecmp(s, "D0") == 0)
+        return power_state_enum::d0;
+    else if (strcasecmp(s, "D1") == 0)
+        return power_state_enum::d1;
+    else if (strcasecmp(s, "D2") == 0)
+        return power_state_enum::d2;
+    else if (strcasecmp(s, "D3hot") == 0)
+        return power_state_enum::d3hot;
+    else if (strcasecmp(s, "D3cold") == 0 || strcasecmp(s, "D3") == 0)
+        return power_state_enum::d3cold;
+
+    return power_state_enum::unknown;
+}
+
+static power_state_enum read_power_state (sysfs_attribute const & attr)
+{
+    char buf[BUF_SZ];
+
+    if (attr.read(buf, sizeof(buf)) <= 0)
+        return power_state_enum::unknown;
+
+    return parse_power_state(buf);
+}
+
+void acpi_devices::discover ()
+{
+    _devices.clear();
+    _path_index.clear();
+    _hid_index.clear();
+
+    acquire_devices(_root_dir.c_str(), 0, [this] (char const * direntry, int) {
+        std::string root_dir {_root_dir};
+        root_dir += '/';
+        root_dir += direntry;
+
+        _devices.emplace_back();
+        auto & dev = _devices.back();
+        dev.name = direntry;
+        dev.hid  = read_all(root_dir + "/hid", true);
+        dev.path = read_all(root_dir + "/path", true);
+
+        auto status = read_all(root_dir + "/status", true);
+        dev.status = -1;
+
+        if (!status.empty())
+            dev.status = unit_value(status);
+
+        // Power state attributes are available only for devices with
+        // power management support
+        dev.power_state_attr.open(root_dir + "/power_state");
+        dev.real_power_state_attr.open(root_dir + "/real_power_state");
+        dev.power_state = read_power_state(dev.power_state_attr);
+        dev.real_power_state = read_power_state(dev.real_power_state_attr);
+    });
+
+    for (int i = 0; i < _devices.size(); i++) {
+        auto const & dev = _devices[i];
+
+        if (!dev.path.empty())
+            _path_index.emplace(dev.path, i);
+
+        if (!dev.hid.empty())
+            _hid_index.emplace(dev.hid, i);
+    }
+}
+
+void acpi_devices::refresh ()
+{
+    for (auto & dev: _devices) {
+        if (dev.power_state_attr.is_open())
+            dev.power_state = read_power_state(dev.power_state_attr);
+
+        if (dev.real_power_state_attr.is_open())
+            dev.real_power_state = read_power_state(dev.real_power_state_attr);
+    }
+}
+
+} // namespace details
+
+acpi_devices::acpi_devices ()
+    : acpi_devices("/sys")
+{}
+
+acpi_devices::acpi_devices (std::string const & sysfs_root)
+{
+    _d.reset(new details::acpi_devices(sysfs_root));
+}
+
+acpi_devices::~acpi_devices ()
+{}
+
+void acpi_devices::discover ()
+{
+    _d->discover();
+}
+
+void acpi_devices::refresh ()
+{
+    _d->refresh();
+}
+
+size_t acpi_devices::devices_available () const
+{
+    return _d->devices_available();
+}
+
+acpi_device acpi_devices::device_at (int index) const
+{
+    return _d->device_at(index);
+}
+
+int acpi_devices::find_by_path (std::string const & path) const
+{
+    return _d->find_by_path(path);
+}
+
+std::vector<int> acpi_devices::find_by_hid (std::string const & hid) const
+{
+    return _d->find_by_hid(hid);
+}
+
+std::vector<int> acpi_devices::find_by_power_state (power_state_enum state) const
+{
+    return _d->find_by_power_state(state);
+}
+
+} // namespace pfs
@@ -0,0 +1,351 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026 Vladislav Trifochkin
+//
+// This file is part of [pfs-acpi](https://github.com/semenovf/pfs-acpi) library.
+//
+// Changelog:
+//      2026.10.17 Initial version
+////////////////////////////////////////////////////////////////////////////////
+#include "pfs/acpi/event.hpp"
+#include <cerrno>
+#include <cstring>
+#include <sys/socket.h>
+#include <linux/netlink.h>
+#include <linux/genetlink.h>
+#include <unistd.h>
+
+//
+// [ACPI event generic netlink interface](https://elixir.bootlin.com/linux/latest/source/drivers/acpi/event.c)
+//
+
+namespace pfs {
+
+static char const * ACPI_GENL_FAMILY_NAME = "acpi_event";
+static char const * ACPI_GENL_MCAST_GROUP_NAME = "acpi_mc_group";
+static int const ACPI_GENL_ATTR_EVENT = 1;
+static int const ACPI_GENL_CMD_EVENT = 1;
+static size_t const RECV_BUF_SZ = 8192;
+
+namespace details {
+
+// Mirrors `struct acpi_genl_event` from drivers/acpi/event.c
+struct acpi_genl_event
+{
+    char device_class[20];
+    char bus_id[15];
+    std::uint32_t type;
+    std::uint32_t data;
+};
+
+inline struct nlattr * nla_first (void * data)
+{
+    return static_cast<struct nlattr *>(data);
+}
+
+inline bool nla_ok (struct nlattr const * nla, int remaining)
+{
+    return remaining >= static_cast<int>(sizeof(*nla))
+        && nla->nla_len >= sizeof(*nla)
+        && nla->nla_len <= remaining;
+}
+
+inline struct nlattr * nla_next (struct nlattr * nla, int & remaining)
+{
+    auto len = NLA_ALIGN(nla->nla_len);
+    remaining -= len;
+    return reinterpret_cast<struct nlattr *>(reinterpret_cast<char *>(nla) + len);
+}
+
+inline void * nla_data (struct nlattr * nla)
+{
+    return reinterpret_cast<char *>(nla) + NLA_HDRLEN;
+}
+
+inline int nla_payload_len (struct nlattr const * nla)
+{
+    return static_cast<int>(nla->nla_len) - NLA_HDRLEN;
+}
+
+inline std::string bounded_string (char const * s, size_t maxlen)
+{
+    return std::string{s, strnlen(s, maxlen)};
+}
+
+// Parses multicast groups nested attribute and returns identifier of
+// the group `name` or -1 if not found.
+static int find_mcast_group (struct nlattr * groups, char const * name)
+{
+    int remaining = nla_payload_len(groups);
+
+    for (auto grp = nla_first(nla_data(groups)); nla_ok(grp, remaining); grp = nla_next(grp, remaining)) {
+        int group_id = -1;
+        bool name_matches = false;
+        int grp_remaining = nla_payload_len(grp);
+
+        for (auto a = nla_first(nla_data(grp)); nla_ok(a, grp_remaining); a = nla_next(a, grp_remaining)) {
+            switch (a->nla_type & NLA_TYPE_MASK) {
+                case CTRL_ATTR_MCAST_GRP_NAME:
+                    name_matches = strncmp(static_cast<char const *>(nla_data(a))
+                        , name, nla_payload_len(a)) == 0;
+                    break;
+                case CTRL_ATTR_MCAST_GRP_ID:
+                    std::uint32_t id;
+                    memcpy(& id, nla_data(a), sizeof(id));
+                    group_id = static_cast<int>(id);
+                    break;
+                default:
+                    break;
+            }
+        }
+
+        if (name_matches)
+            return group_id;
+    }
+
+    return -1;
+}
+
+// Requests family identifier and multicast group identifier from generic
+// netlink controller.
+static bool resolve_family (int fd, int & family_id, int & group_id)
+{
+    struct {
+        struct nlmsghdr n;
+        struct genlmsghdr g;
+        char buf[64];
+    } req;
+
+    memset(& req, 0, sizeof(req));
+
+    auto name_len = strlen(ACPI_GENL_FAMILY_NAME) + 1;
+    auto nla = reinterpret_cast<struct nlattr *>(reinterpret_cast<char *>(& req.g) + GENL_HDRLEN);
+    nla->nla_type = CTRL_ATTR_FAMILY_NAME;
+    nla->nla_len = NLA_HDRLEN + name_len;
+    memcpy(nla_data(nla), ACPI_GENL_FAMILY_NAME, name_len);
+
+    req.n.nlmsg_len = NLMSG_LENGTH(GENL_HDRLEN + NLA_ALIGN(nla->nla_len));
+    req.n.nlmsg_type = GENL_ID_CTRL;
+    req.n.nlmsg_flags = NLM_F_REQUEST;
+    req.n.nlmsg_seq = 1;
+    req.g.cmd = CTRL_CMD_GETFAMILY;
+    req.g.version = 1;
+
+    struct sockaddr_nl kernel;
+    memset(& kernel, 0, sizeof(kernel));
+    kernel.nl_family = AF_NETLINK;
+
+    auto rc = ::sendto(fd, & req, req.n.nlmsg_len, 0
+        , reinterpret_cast<struct sockaddr *>(& kernel), sizeof(kernel));
+
+    if (rc < 0)
+        return false;
+
+    alignas(struct nlmsghdr) char buf[RECV_BUF_SZ];
+    auto n = ::recv(fd, buf, sizeof(buf), 0);
+
+    if (n <= 0)
+        return false;
+
+    family_id = -1;
+    group_id = -1;
+
+    int len = static_cast<int>(n);
+
+    for (auto nh = reinterpret_cast<struct nlmsghdr *>(buf); NLMSG_OK(nh, len); nh = NLMSG_NEXT(nh, len)) {
+        if (nh->nlmsg_type == NLMSG_ERROR || nh->nlmsg_type != GENL_ID_CTRL)
+            return false;
+
+        auto attrs = static_cast<char *>(NLMSG_DATA(nh)) + GENL_HDRLEN;
+        int remaining = static_cast<int>(nh->nlmsg_len) - NLMSG_LENGTH(GENL_HDRLEN);
+
+        for (auto a = nla_first(attrs); nla_ok(a, remaining); a = nla_next(a, remaining)) {
+            switch (a->nla_type & NLA_TYPE_MASK) {
+                case CTRL_ATTR_FAMILY_ID:
+                    std::uint16_t id;
+                    memcpy(& id, nla_data(a), sizeof(id));
+                    family_id = id;
+                    break;
+                case CTRL_ATTR_MCAST_GROUPS:
+                    group_id = find_mcast_group(a, ACPI_GENL_MCAST_GROUP_NAME);
+                    break;
+                default:
+                    break;
+            }
+        }
+    }
+
+    return family_id >= 0 && group_id >= 0;
+}
+
+} // namespace details
+
+acpi_event_listener::acpi_event_listener ()
+{}
+
+acpi_event_listener::~acpi_event_listener ()
+{
+    close();
+}
+
+bool acpi_event_listener::open ()
+{
+    close();
+
+    _fd = ::socket(AF_NETLINK, SOCK_RAW | SOCK_CLOEXEC, NETLINK_GENERIC);
+
+    if (_fd < 0)
+        return false;
+
+    struct sockaddr_nl local;
+    memset(& local, 0, sizeof(local));
+    local.nl_family = AF_NETLINK;
+
+    int group_id = -1;
+
+    bool success = ::bind(_fd, reinterpret_cast<struct sockaddr *>(& local), sizeof(local)) == 0
+        && details::resolve_family(_fd, _family_id, group_id)
+        && ::setsockopt(_fd, SOL_NETLINK, NETLINK_ADD_MEMBERSHIP
+            , & group_id, sizeof(group_id)) == 0;
+
+    if (!success) {
+        close();
+        return false;
+    }
+
+    return true;
+}
+
+void acpi_event_listener::close ()
+{
+    if (_fd >= 0) {
+        ::close(_fd);
+        _fd = -1;
+    }
+
+    _family_id = -1;
+}
+
+bool acpi_event_listener::is_open () const
+{
+    return _fd >= 0;
+}
+
+int acpi_event_listener::native_handle () const
+{
+    return _fd;
+}
+
+int acpi_event_listener::receive (std::vector<acpi_event> & events)
+{
+    if (_fd < 0)
+        return -1;
+
+    alignas(struct nlmsghdr) char buf[RECV_BUF_SZ];
+    int count = 0;
+
+    for (;;) {
+        auto n = ::recv(_fd, buf, sizeof(buf), MSG_DONTWAIT);
+
+        if (n < 0) {
+            if (errno == EAGAIN || errno == EWOULDBLOCK)
+                break;
+
+            // ENOBUFS means events were dropped by kernel, caller should
+            // acquire all devices
+            return errno == EINTR ? count : -1;
+        }
+
+        if (n == 0)
+            break;
+
+        count += parse(buf, static_cast<size_t>(n), _family_id, events);
+    }
+
+    return count;
+}
+
+int acpi_event_listener::process (acpi & a)
+{
+    std::vector<acpi_event> events;
+    auto count = receive(events);
+
+    if (count < 0) {
+        a.acquire();
+        return -1;
+    }
+
+    for (auto const & ev: events)
+        apply(ev, a);
+
+    return count;
+}
+
+int acpi_event_listener::parse (void const * buf, std::size_t len, int family_id
+    , std::vector<acpi_event> & events)
+{
+    int count = 0;
+    int remaining = static_cast<int>(len);
+    auto nh = reinterpret_cast<struct nlmsghdr *>(const_cast<void *>(buf));
+
+    for (; NLMSG_OK(nh, remaining); nh = NLMSG_NEXT(nh, remaining)) {
+        if (nh->nlmsg_type != family_id)
+            continue;
+
+        if (nh->nlmsg_len < NLMSG_LENGTH(GENL_HDRLEN))
+            continue;
+
+        auto genl = static_cast<struct genlmsghdr *>(NLMSG_DATA(nh));
+
+        if (genl->cmd != ACPI_GENL_CMD_EVENT)
+            continue;
+
+        auto attrs = reinterpret_cast<char *>(genl) + GENL_HDRLEN;
+        int attrs_remaining = static_cast<int>(nh->nlmsg_len) - NLMSG_LENGTH(GENL_HDRLEN);
+
+        for (auto a = details::nla_first(attrs); details::nla_ok(a, attrs_remaining)
+                ; a = details::nla_next(a, attrs_remaining)) {
+            if ((a->nla_type & NLA_TYPE_MASK) != ACPI_GENL_ATTR_EVENT)
+                continue;
+
+            if (details::nla_payload_len(a) < static_cast<int>(sizeof(details::acpi_genl_event)))
+                continue;
+
+            details::acpi_genl_event raw;
+            memcpy(& raw, details::nla_data(a), sizeof(raw));
+
+            acpi_event ev;
+            ev.device_class = details::bounded_string(raw.device_class, sizeof(raw.device_class));
+            ev.bus_id = details::bounded_string(raw.bus_id, sizeof(raw.bus_id));
+            ev.type = raw.type;
+            ev.data = raw.data;
+            events.push_back(std::move(ev));
+            ++count;
+        }
+    }
+
+    return count;
+}
+
+int acpi_event_listener::affected_devices (acpi_event const & ev)
+{
+    if (ev.device_class == "battery")
+        return acpi::dev_battery;
+
+    if (ev.device_class == "ac_adapter")
+        return acpi::dev_ac_adapter;
+
+    if (ev.device_class == "thermal_zone")
+        return acpi::dev_thermal_zone;
+
+    return acpi::dev_none;
+}
+
+void acpi_event_listener::apply (acpi_event const & ev, acpi & a)
+{
+    auto devices = affected_devices(ev);
+
+    if (devices != acpi::dev_none)
+        a.acquire(devices, ev.bus_id);
+}
+
+} // namespace pfs
@@ -7,45 +7,432 @@
 //      2020.04.10 Initial version
 ////////////////////////////////////////////////////////////////////////////////
 #include "pfs/acpi.hpp"
+#include "sysfs.hpp"
+#include <algorithm>
 #include <string>
 #include <vector>
+#include <cstdint>
 #include <cstdio>
 #include <cstring>
 #include <sys/types.h>
 #include <dirent.h>
+#include <limits.h>
 #include <strings.h>
 #include <unistd.h>
-#include <iomanip>
+#include <time.h>
+
+#if !PFS_ACPI_FIXED_CAPACITY
+#   include <iomanip>
+#endif
 
 namespace pfs {
 
 static char const * ACPI_POWER_SUPPLY_PATH = "/sys/class/power_supply";
 static char const * ACPI_THERMAL_PATH = "/sys/class/thermal";
-static size_t BUF_SZ = 64;
 static double MIN_CAPACITY = double{0.01};
 static double MIN_PRESENT_RATE = double{0.01};
 
+// Number of recent temperature samples the thermal trend is estimated on
+static size_t const THERMAL_TREND_WINDOW = 10;
+static int const THERMAL_TREND_MIN_SAMPLES = 3;
+
 namespace details {
 
 struct battery_extended : battery
 {
-    int remaining_capacity;
-    int remaining_energy;
-    int present_rate;
-    int last_capacity;
-    int last_capacity_unit;
+    int remaining_capacity {0};
+    int remaining_energy {0};
+    int present_rate {0};
+    int last_capacity {0};
+    int last_capacity_unit {0};
+
+    int voltage {0};
+
+    acpi_string bus_id;
+
+#if PFS_ACPI_PMR
+    PFS_ACPI_ALLOCATOR_AWARE(battery_extended)
+    explicit battery_extended (allocator_type alloc)
+        : battery(alloc)
+        , bus_id(alloc)
+    {}
+#endif
+};
+
+struct ac_adapter_extended : ac_adapter
+{
+    acpi_string bus_id;
+
+#if PFS_ACPI_PMR
+    PFS_ACPI_ALLOCATOR_AWARE(ac_adapter_extended)
+    explicit ac_adapter_extended (allocator_type alloc)
+        : ac_adapter(alloc)
+        , bus_id(alloc)
+    {}
+#endif
+};
+
+struct ups_extended : ups
+{
+    acpi_string bus_id;
+
+#if PFS_ACPI_PMR
+    PFS_ACPI_ALLOCATOR_AWARE(ups_extended)
+    explicit ups_extended (allocator_type alloc)
+        : ups(alloc)
+        , bus_id(alloc)
+    {}
+#endif
+};
+
+struct usb_power_supply_extended : usb_power_supply
+{
+    acpi_string bus_id;
+
+#if PFS_ACPI_PMR
+    PFS_ACPI_ALLOCATOR_AWARE(usb_power_supply_extended)
+    explicit usb_power_supply_extended (allocator_type alloc)
+        : usb_power_supply(alloc)
+        , bus_id(alloc)
+    {}
+#endif
+};
+
+// Ring buffer of recent temperature samples with least squares slope
+// estimation
+class thermal_history
+{
+public:
+    void append (double t, double temperature)
+    {
+        _t[_head] = t;
+        _temperature[_head] = temperature;
+        _head = (_head + 1) % THERMAL_TREND_WINDOW;
+
+        if (_count < THERMAL_TREND_WINDOW)
+            ++_count;
+    }
+
+    int size () const
+    {
+        return static_cast<int>(_count);
+    }
+
+    // Returns slope in degrees per second
+    double slope () const
+    {
+        if (_count < 2)
+            return 0;
+
+        // Times are shifted to the oldest sample to keep precision
+        auto base = _t[(_head + THERMAL_TREND_WINDOW - _count) % THERMAL_TREND_WINDOW];
+        double sum_t = 0, sum_y = 0, sum_tt = 0, sum_ty = 0;
+
+        for (size_t i = 0; i < _count; i++) {
+            auto t = _t[i] - base;
+            auto y = _temperature[i];
+            sum_t += t;
+            sum_y += y;
+            sum_tt += t * t;
+            sum_ty += t * y;
+        }
+
+        auto n = static_cast<double>(_count);
+        auto denominator = n * sum_tt - sum_t * sum_t;
+
+        if (denominator <= 0)
+            return 0;
+
+        return (n * sum_ty - sum_t * sum_y) / denominator;
+    }
+
+private:
+    double _t[THERMAL_TREND_WINDOW];
+    double _temperature[THERMAL_TREND_WINDOW];
+    size_t _head {0};
+    size_t _count {0};
+};
+
+struct thermal_zone_extended : thermal_zone
+{
+    acpi_string bus_id;
+    std::int32_t millidegrees {INT32_MIN};
+    std::int64_t timestamp_ns {0};
+    bool trip_points_acquired {false};
+    thermal_history history;
+    thermal_trend trend;
+
+#if PFS_ACPI_PMR
+    PFS_ACPI_ALLOCATOR_AWARE(thermal_zone_extended)
+    explicit thermal_zone_extended (allocator_type alloc)
+        : thermal_zone(alloc)
+        , bus_id(alloc)
+        , trend(alloc)
+    {}
+#endif
+};
+
+struct fan_extended : fan
+{
+    acpi_string bus_id;
+    cooling_stats stats;
+
+#if PFS_ACPI_PMR
+    PFS_ACPI_ALLOCATOR_AWARE(fan_extended)
+    explicit fan_extended (allocator_type alloc)
+        : fan(alloc)
+        , bus_id(alloc)
+        , stats(alloc)
+    {}
+#endif
+};
+
+// Attributes with dynamic values, they are opened by device acquisition
+// and re-read by `refresh()`
+enum battery_attr_enum {
+      battery_status
+    , battery_charge_now
+    , battery_energy_now
+    , battery_current_now
+    , battery_power_now
+    , battery_charge_full
+    , battery_energy_full
+    , battery_voltage_now
+    , battery_attr_count
+};
+
+static char const * const BATTERY_ATTRS[] = {
+      "/status"
+    , "/charge_now"
+    , "/energy_now"
+    , "/current_now"
+    , "/power_now"
+    , "/charge_full"
+    , "/energy_full"
+    , "/voltage_now"
+};
+
+enum ac_adapter_attr_enum {
+      ac_adapter_online
+    , ac_adapter_attr_count
+};
+
+static char const * const AC_ADAPTER_ATTRS[] = {
+      "/online"
+};
+
+enum ups_attr_enum {
+      ups_online
+    , ups_status
+    , ups_capacity
+    , ups_time_to_empty_now
+    , ups_time_to_empty_avg
+    , ups_time_to_full_now
+    , ups_time_to_full_avg
+    , ups_power_now
+    , ups_attr_count
+};
+
+static char const * const UPS_ATTRS[] = {
+      "/online"
+    , "/status"
+    , "/capacity"
+    , "/time_to_empty_now"
+    , "/time_to_empty_avg"
+    , "/time_to_full_now"
+    , "/time_to_full_avg"
+    , "/power_now"
+};
+
+enum usb_power_supply_attr_enum {
+      usb_online
+    , usb_voltage_now
+    , usb_current_max
+    , usb_input_current_limit
+    , usb_input_power_limit
+    , usb_attr_count
+};
+
+static char const * const USB_POWER_SUPPLY_ATTRS[] = {
+      "/online"
+    , "/voltage_now"
+    , "/current_max"
+    , "/input_current_limit"
+    , "/input_power_limit"
+};
+
+enum thermal_zone_attr_enum {
+      thermal_zone_temp
+    , thermal_zone_attr_count
+};
+
+static char const * const THERMAL_ZONE_ATTRS[] = {
+      "/temp"
+};
+
+enum fan_attr_enum {
+      fan_cur_state
+    , fan_speed_rpm
+    , fan_time_in_state
+    , fan_total_trans
+    , fan_attr_count
+};
+
+// ACPI 4.0 fan attributes are created by ACPI fan driver on the ACPI
+// companion (PNP0C0B, INT3404, ...) of the platform device the cooling
+// device is bound to.
+static char const * const FAN_ATTRS[] = {
+      "/cur_state"
+    , "/device/firmware_node/fan_speed_rpm"
+    , "/stats/time_in_state_ms"
+    , "/stats/total_trans"
+};
+
+// Attributes source for device acquisition: reads attributes by path
+class path_source
+{
+public:
+    path_source (std::string const & root_dir, char const * const * attrs)
+        : _root_dir(root_dir)
+        , _attrs(attrs)
+    {}
+
+    bool read (int attr, int & value) const
+    {
+        auto s = read_all(_root_dir + _attrs[attr], true);
+
+        if (s.empty())
+            return false;
+
+        value = unit_value(s);
+        return true;
+    }
+
+    bool read (int attr, char * buf, size_t size) const
+    {
+        auto s = read_all(_root_dir + _attrs[attr], true);
+
+        if (s.empty())
+            return false;
+
+        auto n = std::min(s.size(), size - 1);
+        s.copy(buf, n);
+        buf[n] = '\x0';
+        return true;
+    }
+
+private:
+    std::string const & _root_dir;
+    char const * const * _attrs;
+};
+
+// Attributes source for `refresh()`: reads attributes through file
+// descriptors opened by device acquisition
+template <size_t N>
+class attribute_set
+{
+public:
+    void open (std::string const & root_dir, char const * const * names, int device)
+    {
+        for (size_t i = 0; i < N; i++)
+            _attrs[i].open(root_dir + names[i], O_RDONLY, device);
+    }
+
+    bool read (int attr, int & value) const
+    {
+        long long n = 0;
 
-    int voltage;
+        if (!_attrs[attr].read_int(n))
+            return false;
+
+        value = static_cast<int>(n);
+        return true;
+    }
+
+    bool read (int attr, char * buf, size_t size) const
+    {
+        return _attrs[attr].read(buf, size) > 0;
+    }
+
+private:
+    sysfs_attribute _attrs[N];
 };
 
+using battery_attrs = attribute_set<battery_attr_count>;
+using ac_adapter_attrs = attribute_set<ac_adapter_attr_count>;
+using ups_attrs = attribute_set<ups_attr_count>;
+using usb_power_supply_attrs = attribute_set<usb_attr_count>;
+using thermal_zone_attrs = attribute_set<thermal_zone_attr_count>;
+using fan_attrs = attribute_set<fan_attr_count>;
+
+// Containers have fixed capacity in heap-free profile
+template <typename Container>
+static bool has_room (Container const & c)
+{
+    return c.size() < c.max_size();
+}
+
 class acpi
 {
 public:
+#if PFS_ACPI_PMR
+    explicit acpi (std::pmr::memory_resource * mr)
+        : _batteries(mr)
+        , _ac_adapters(mr)
+        , _ups(mr)
+        , _usb_power_supplies(mr)
+        , _thermal_zones(mr)
+        , _fans(mr)
+        , _battery_attrs(mr)
+        , _ac_adapter_attrs(mr)
+        , _ups_attrs(mr)
+        , _usb_power_supply_attrs(mr)
+        , _thermal_zone_attrs(mr)
+        , _fan_attrs(mr)
+    {}
+
+    std::pmr::memory_resource * resource () const
+    {
+        return _batteries.get_allocator().resource();
+    }
+
+    acpi_allocator allocator () const
+    {
+        return acpi_allocator{resource()};
+    }
+#else
     acpi ()
     {}
 
+    std::allocator<char> allocator () const
+    {
+        return std::allocator<char>{};
+    }
+#endif
+
+    // Classes are looked up under `<sysfs_root>/class` (e.g. fake sysfs tree)
+    void set_sysfs_root (std::string const & sysfs_root)
+    {
+        _power_supply_path = sysfs_root + "/class/power_supply";
+        _thermal_path = sysfs_root + "/class/thermal";
+    }
+
+    // Copies data for the caller into memory of the instance
+    template <typename T>
+    T copy_of (T const & data) const
+    {
+#if PFS_ACPI_PMR
+        return T(data, allocator());
+#else
+        return data;
+#endif
+    }
+
     void acquire_power_supply (int devices);
     void acquire_thermal (int devices);
+    void refresh (int devices);
+    bool refresh_power_supply (int devices, std::string const & bus_id);
+    bool refresh_thermal (int devices, std::string const & bus_id);
 
     size_t batteries_available () const
     {
@@ -57,6 +444,16 @@ public:
         return _ac_adapters.size();
     }
 
+    size_t ups_available () const
+    {
+        return _ups.size();
+    }
+
+    size_t usb_power_supplies_available () const
+    {
+        return _usb_power_supplies.size();
+    }
+
     size_t thermal_zones_available () const
     {
         return _thermal_zones.size();
@@ -70,278 +467,909 @@ public:
     battery battery_at (int index) const
     {
         if (index >= 0 && index < _batteries.size()) {
-            return _batteries[index];
+            return copy_of<battery>(_batteries[index]);
         }
-        return battery{};
+        return copy_of(battery{});
     }
 
     ac_adapter ac_adapter_at (int index) const
     {
         if (index >= 0 && index < _ac_adapters.size()) {
-            return _ac_adapters[index];
+            return copy_of<ac_adapter>(_ac_adapters[index]);
+        }
+        return copy_of(ac_adapter{});
+    }
+
+    ups ups_at (int index) const
+    {
+        if (index >= 0 && index < _ups.size()) {
+            return copy_of<ups>(_ups[index]);
+        }
+        return copy_of(ups{});
+    }
+
+    usb_power_supply usb_power_supply_at (int index) const
+    {
+        if (index >= 0 && index < _usb_power_supplies.size()) {
+            return copy_of<usb_power_supply>(_usb_power_supplies[index]);
+        }
+        return copy_of(usb_power_supply{});
+    }
+
+    thermal_zone thermal_zone_at (int index) const
+    {
+        if (index >= 0 && index < _thermal_zones.size()) {
+            return copy_of<thermal_zone>(_thermal_zones[index]);
+        }
+        return copy_of(thermal_zone{});
+    }
+
+    thermal_trend thermal_trend_at (int index) const
+    {
+        if (index >= 0 && index < _thermal_zones.size()) {
+            return copy_of(_thermal_zones[index].trend);
+        }
+        return copy_of(thermal_trend{});
+    }
+
+    size_t thermal_zones_soa (std::int32_t * millidegrees
+        , std::int64_t * timestamps_ns
+        , std::uint64_t * valid
+        , size_t capacity) const
+    {
+        auto n = _thermal_zones.size() < capacity ? _thermal_zones.size() : capacity;
+
+        for (size_t i = 0; i < (capacity + 63) / 64; i++)
+            valid[i] = 0;
+
+        for (size_t i = 0; i < n; i++) {
+            auto const & tz = _thermal_zones[i];
+            millidegrees[i] = tz.millidegrees;
+            timestamps_ns[i] = tz.timestamp_ns;
+
+            if (tz.millidegrees != INT32_MIN)
+                valid[i / 64] |= std::uint64_t{1} << (i % 64);
+        }
+
+        return n;
+    }
+
+    std::uint64_t generation () const
+    {
+        return _generation;
+    }
+
+    void next_generation ()
+    {
+        ++_generation;
+    }
+
+    std::uint64_t acquisition_generation () const
+    {
+        return _acquisition_generation;
+    }
+
+    void next_acquisition_generation ()
+    {
+        ++_acquisition_generation;
+    }
+
+    copy_result temperatures (float * out, size_t capacity) const
+    {
+        auto n = std::min(capacity, _thermal_zones.size());
+
+        for (size_t i = 0; i < n; i++)
+            out[i] = _thermal_zones[i].temperature;
+
+        return copy_result{n, _generation};
+    }
+
+    copy_result battery_percentages (int * out, size_t capacity) const
+    {
+        auto n = std::min(capacity, _batteries.size());
+
+        for (size_t i = 0; i < n; i++)
+            out[i] = _batteries[i].percentage;
+
+        return copy_result{n, _generation};
+    }
+
+    copy_result battery_rates (int * out, size_t capacity) const
+    {
+        auto n = std::min(capacity, _batteries.size());
+
+        for (size_t i = 0; i < n; i++)
+            out[i] = _batteries[i].present_rate;
+
+        return copy_result{n, _generation};
+    }
+
+    copy_result fan_states (int * cur_states, int * max_states, size_t capacity) const
+    {
+        auto n = std::min(capacity, _fans.size());
+
+        for (size_t i = 0; i < n; i++)
+            cur_states[i] = _fans[i].cur_state;
+
+        if (max_states) {
+            for (size_t i = 0; i < n; i++)
+                max_states[i] = _fans[i].max_state;
+        }
+
+        return copy_result{n, _generation};
+    }
+
+    acpi_vector<acpi_string> thermal_zone_names () const
+    {
+        acpi_vector<acpi_string> result(allocator());
+        result.reserve(_thermal_zones.size());
+
+        for (auto const & tz: _thermal_zones)
+            result.push_back(tz.name);
+
+        return result;
+    }
+
+    fan fan_at (int index) const
+    {
+        if (index >= 0 && index < _fans.size()) {
+            return copy_of<fan>(_fans[index]);
+        }
+        return copy_of(fan{});
+    }
+
+    cooling_stats cooling_stats_at (int index) const
+    {
+        if (index >= 0 && index < _fans.size()) {
+            return copy_of(_fans[index].stats);
+        }
+        return copy_of(cooling_stats{});
+    }
+
+#if !PFS_ACPI_FIXED_CAPACITY
+    void dump (std::ostream & out, bool extended_data);
+#endif
+
+private:
+    acpi_vector<battery_extended>      _batteries;
+    acpi_vector<ac_adapter_extended>   _ac_adapters;
+    acpi_vector<ups_extended>          _ups;
+    acpi_vector<usb_power_supply_extended> _usb_power_supplies;
+    acpi_vector<thermal_zone_extended> _thermal_zones;
+    acpi_vector<fan_extended>          _fans;
+
+    // Index aligned with devices
+    acpi_vector<battery_attrs>          _battery_attrs;
+    acpi_vector<ac_adapter_attrs>       _ac_adapter_attrs;
+    acpi_vector<ups_attrs>              _ups_attrs;
+    acpi_vector<usb_power_supply_attrs> _usb_power_supply_attrs;
+    acpi_vector<thermal_zone_attrs>     _thermal_zone_attrs;
+    acpi_vector<fan_attrs>              _fan_attrs;
+    std::uint64_t _generation {0};
+    std::uint64_t _acquisition_generation {0};
+
+    std::string _power_supply_path {ACPI_POWER_SUPPLY_PATH};
+    std::string _thermal_path {ACPI_THERMAL_PATH};
+};
+
+// Returns name of the ACPI device the sysfs entry is bound to (e.g. `PNP0C0A:00`)
+// or empty string if entry has no `device` link.
+static std::string read_bus_id (std::string const & root_dir)
+{
+    std::string target;
+
+    if (!read_link(root_dir + "/device", target))
+        return std::string{};
+
+    auto pos = target.rfind('/');
+    return pos != std::string::npos ? target.substr(pos + 1) : target;
+}
+
+template <typename Source>
+static int optional_value (Source const & src, int attr, int divider)
+{
+    int value = 0;
+    return src.read(attr, value) ? value / divider : -1;
+}
+
+template <typename Source>
+static charge_state_enum read_charge_state (Source const & src, int attr)
+{
+    char charge_state[BUF_SZ];
+
+    if (!src.read(attr, charge_state, sizeof(charge_state)))
+        return charge_state_enum::unknown;
+
+    if (strncasecmp(charge_state, "disch", 5) == 0)
+        return charge_state_enum::discharge;
+    else if (strncasecmp (charge_state, "full", 4) == 0)
+        return charge_state_enum::charged;
+    else if (strncasecmp (charge_state, "chargi", 6) == 0)
+        return charge_state_enum::charge;
+
+    return charge_state_enum::unknown;
+}
+
+template <typename Source>
+static void read_battery_values (Source const & src, battery_extended & bat)
+{
+    bat.charge_state = read_charge_state(src, battery_status);
+
+    ////////////////////////////////////////////////////////////////////////
+    bat.remaining_capacity = optional_value(src, battery_charge_now, 1000);
+    bat.remaining_energy = optional_value(src, battery_energy_now, 1000);
+
+    ////////////////////////////////////////////////////////////////////////
+    int present_rate = 0;
+    bat.present_rate = -1;
+
+    if (src.read(battery_current_now, present_rate) || src.read(battery_power_now, present_rate))
+        bat.present_rate = present_rate / 1000;
+
+    ////////////////////////////////////////////////////////////////////////
+    bat.last_capacity = optional_value(src, battery_charge_full, 1000);
+    bat.last_capacity_unit = optional_value(src, battery_energy_full, 1000);
+
+    ////////////////////////////////////////////////////////////////////////
+    bat.voltage = optional_value(src, battery_voltage_now, 1000);
+
+    if (!bat.voltage)
+        bat.voltage = -1;
+
+    ////////////////////////////////////////////////////////////////////////
+    // Recalculate attribute values
+    ////////////////////////////////////////////////////////////////////////
+    if (bat.last_capacity_unit != -1 && bat.last_capacity == -1) {
+        if (bat.voltage != -1) {
+            bat.last_capacity = bat.last_capacity_unit * 1000 / bat.voltage;
+        } else {
+            bat.last_capacity = bat.last_capacity_unit;
+        }
+    }
+
+    if (bat.remaining_energy != -1 && bat.remaining_capacity == -1) {
+        if (bat.voltage != -1) {
+            bat.remaining_capacity = bat.remaining_energy * 1000 / bat.voltage;
+            bat.present_rate = bat.present_rate * 1000 / bat.voltage;
+        } else {
+            bat.remaining_capacity = bat.remaining_energy;
+        }
+    }
+
+    if (bat.last_capacity < MIN_CAPACITY)
+        bat.percentage = 0;
+    else
+        bat.percentage = bat.remaining_capacity * 100 / bat.last_capacity;
+
+    if (bat.percentage > 100)
+        bat.percentage = 100;
+
+    bat.seconds = -1;
+
+    if (bat.present_rate == -1) {
+        bat.seconds = -1;
+    } else if (bat.charge_state == charge_state_enum::charge) {
+        if (bat.present_rate > MIN_PRESENT_RATE) {
+            bat.seconds = 3600 * (bat.last_capacity - bat.remaining_capacity) / bat.present_rate;
+        } else {
+            bat.seconds = -1; // charging at zero rate
+        }
+    } else if (bat.charge_state == charge_state_enum::discharge) {
+        if (bat.present_rate > MIN_PRESENT_RATE) {
+            bat.seconds = 3600 * bat.remaining_capacity / bat.present_rate;
+        } else {
+            bat.seconds = -1; //discharging at zero rate
+        }
+    } else {
+        bat.seconds = -1;
+    }
+}
+
+static void read_battery (std::string const & root_dir, battery_extended & bat)
+{
+    bat.manufacturer = read_all(root_dir + "/manufacturer", true);
+    bat.model_name = read_all(root_dir + "/model_name", true);
+    bat.technology = read_all(root_dir + "/technology", true);
+    read_battery_values(path_source{root_dir, BATTERY_ATTRS}, bat);
+}
+
+template <typename Source>
+static ac_state_enum read_ac_state (Source const & src, int attr)
+{
+    int online = 0;
+
+    if (!src.read(attr, online))
+        return ac_state_enum::unknown;
+
+    return online == 0 ? ac_state_enum::offline : ac_state_enum::online;
+}
+
+template <typename Source>
+static void read_ac_adapter_values (Source const & src, ac_adapter_extended & ac)
+{
+    ac.state = read_ac_state(src, ac_adapter_online);
+}
+
+static void read_ac_adapter (std::string const & root_dir, ac_adapter_extended & ac)
+{
+    read_ac_adapter_values(path_source{root_dir, AC_ADAPTER_ATTRS}, ac);
+}
+
+template <typename Source>
+static void read_ups_values (Source const & src, ups_extended & ups)
+{
+    ups.state = read_ac_state(src, ups_online);
+    ups.charge_state = read_charge_state(src, ups_status);
+
+    // UPS discharges while mains is off-line even if status is not reported
+    if (ups.charge_state == charge_state_enum::unknown && ups.state == ac_state_enum::offline)
+        ups.charge_state = charge_state_enum::discharge;
+
+    ups.percentage = optional_value(src, ups_capacity, 1);
+
+    if (ups.percentage > 100)
+        ups.percentage = 100;
+
+    ups.seconds = -1;
+
+    if (ups.charge_state == charge_state_enum::discharge) {
+        ups.seconds = optional_value(src, ups_time_to_empty_now, 1);
+
+        if (ups.seconds < 0)
+            ups.seconds = optional_value(src, ups_time_to_empty_avg, 1);
+    } else if (ups.charge_state == charge_state_enum::charge) {
+        ups.seconds = optional_value(src, ups_time_to_full_now, 1);
+
+        if (ups.seconds < 0)
+            ups.seconds = optional_value(src, ups_time_to_full_avg, 1);
+    }
+
+    ups.power = optional_value(src, ups_power_now, 1000);
+}
+
+static void read_ups (std::string const & root_dir, ups_extended & ups)
+{
+    ups.manufacturer = read_all(root_dir + "/manufacturer", true);
+    ups.model_name = read_all(root_dir + "/model_name", true);
+    read_ups_values(path_source{root_dir, UPS_ATTRS}, ups);
+}
+
+// Extracts selected value from attribute like `Unknown SDP DCP [PD] PD_PPS`
+// or returns the whole value if there is no selection.
+static std::string selected_value (std::string const & s)
+{
+    auto first = s.find('[');
+
+    if (first == std::string::npos)
+        return s;
+
+    auto last = s.find(']', first);
+
+    if (last == std::string::npos)
+        return s;
+
+    return s.substr(first + 1, last - first - 1);
+}
+
+template <typename Source>
+static void read_usb_power_supply_values (Source const & src, usb_power_supply_extended & usb)
+{
+    usb.state = read_ac_state(src, usb_online);
+    usb.voltage = optional_value(src, usb_voltage_now, 1000);
+    usb.current_max = optional_value(src, usb_current_max, 1000);
+    usb.input_current_limit = optional_value(src, usb_input_current_limit, 1000);
+
+    // Prefer power limit reported by driver, otherwise calculate it from
+    // negotiated voltage and the most restrictive current limit
+    usb.input_power = optional_value(src, usb_input_power_limit, 1000);
+
+    if (usb.input_power < 0 && usb.voltage > 0) {
+        int current = usb.current_max;
+
+        if (usb.input_current_limit > 0 && (current < 0 || usb.input_current_limit < current))
+            current = usb.input_current_limit;
+
+        if (current > 0)
+            usb.input_power = static_cast<int>(static_cast<long long>(usb.voltage) * current / 1000);
+    }
+
+    if (usb.state == ac_state_enum::offline)
+        usb.input_power = 0;
+}
+
+static void read_usb_power_supply (std::string const & root_dir
+    , usb_power_supply_extended & usb)
+{
+    usb.type = read_all(root_dir + "/type", true);
+    usb.usb_type = selected_value(read_all(root_dir + "/usb_type", true));
+    read_usb_power_supply_values(path_source{root_dir, USB_POWER_SUPPLY_ATTRS}, usb);
+}
+
+static std::int64_t monotonic_ns ()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, & ts);
+    return static_cast<std::int64_t>(ts.tv_sec) * 1000000000 + ts.tv_nsec;
+}
+
+// Trip points are static, so they are read once
+static void read_trip_points (std::string const & root_dir, thermal_zone_extended & tz)
+{
+    tz.trend.passive_temperature = -1;
+    tz.trend.critical_temperature = -1;
+
+    for (int i = 0; ; i++) {
+        auto prefix = root_dir + "/trip_point_" + std::to_string(i);
+        auto type = read_all(prefix + "_type", true);
+
+        if (type.empty())
+            break;
+
+        auto temp = read_all(prefix + "_temp", true);
+
+        if (temp.empty())
+            continue;
+
+        auto value = unit_value(temp) / float{1000.0};
+
+        if (value <= 0)
+            continue;
+
+        // The lowest trip point of the type is taken
+        if (type == "passive") {
+            if (tz.trend.passive_temperature < 0 || value < tz.trend.passive_temperature)
+                tz.trend.passive_temperature = value;
+        } else if (type == "critical") {
+            if (tz.trend.critical_temperature < 0 || value < tz.trend.critical_temperature)
+                tz.trend.critical_temperature = value;
         }
-        return ac_adapter{};
     }
 
-    thermal_zone thermal_zone_at (int index) const
-    {
-        if (index >= 0 && index < _thermal_zones.size()) {
-            return _thermal_zones[index];
-        }
-        return thermal_zone{};
+    tz.trip_points_acquired = true;
+}
+
+static float seconds_to_trip (float temperature, float trip_temperature, double slope)
+{
+    if (trip_temperature < 0)
+        return -1;
+
+    if (temperature >= trip_temperature)
+        return 0;
+
+    if (slope <= 0)
+        return -1;
+
+    return static_cast<float>((trip_temperature - temperature) / slope);
+}
+
+static void update_thermal_trend (thermal_zone_extended & tz)
+{
+    tz.trend.name = tz.name;
+
+    if (tz.temperature == -1)
+        return;
+
+    tz.history.append(tz.timestamp_ns / double{1e9}, tz.temperature);
+    tz.trend.samples = tz.history.size();
+    tz.trend.slope = 0;
+    tz.trend.seconds_to_passive = -1;
+    tz.trend.seconds_to_critical = -1;
+
+    if (tz.trend.samples < THERMAL_TREND_MIN_SAMPLES) {
+        // Trip point reached is known without the slope
+        if (tz.trend.passive_temperature >= 0 && tz.temperature >= tz.trend.passive_temperature)
+            tz.trend.seconds_to_passive = 0;
+
+        if (tz.trend.critical_temperature >= 0 && tz.temperature >= tz.trend.critical_temperature)
+            tz.trend.seconds_to_critical = 0;
+
+        return;
+    }
+
+    auto slope = tz.history.slope();
+    tz.trend.slope = static_cast<float>(slope);
+    tz.trend.seconds_to_passive = seconds_to_trip(tz.temperature, tz.trend.passive_temperature, slope);
+    tz.trend.seconds_to_critical = seconds_to_trip(tz.temperature, tz.trend.critical_temperature, slope);
+}
+
+template <typename Source>
+static void read_temperature (Source const & src, thermal_zone_extended & tz)
+{
+    int millidegrees = 0;
+    tz.temperature = -1;
+    tz.millidegrees = INT32_MIN;
+    tz.timestamp_ns = monotonic_ns();
+
+    if (src.read(thermal_zone_temp, millidegrees)) {
+        tz.millidegrees = millidegrees;
+        tz.temperature = tz.millidegrees / float{1000.0};
+    }
+}
+
+static void read_thermal_zone (std::string const & root_dir, thermal_zone_extended & tz)
+{
+    read_temperature(path_source{root_dir, THERMAL_ZONE_ATTRS}, tz);
+
+    if (!tz.trip_points_acquired)
+        read_trip_points(root_dir, tz);
+
+    update_thermal_trend(tz);
+}
+
+// Parses `time_in_state_ms` content calling `f(ms)` for each state:
+//      state0  1234
+//      state1  0
+template <typename F>
+static void for_each_time_in_state (char const * p, F && f)
+{
+    while (*p) {
+        unsigned int state = 0;
+        unsigned long long ms = 0;
+        int n = 0;
+
+        if (sscanf(p, " state%u %llu%n", & state, & ms, & n) != 2)
+            break;
+
+        f(ms);
+        p += n;
     }
+}
 
-    fan fan_at (int index) const
-    {
-        if (index >= 0 && index < _fans.size()) {
-            return _fans[index];
-        }
-        return fan{};
+// Parses `trans_table` content:
+//       From  :    To
+//             :    state0    state1
+//      state0:         0         3
+//      state1:         3         0
+static void parse_trans_table (std::string const & s, size_t states
+    , acpi_vector<unsigned long long> & result)
+{
+    result.assign(states * states, 0);
+
+    // Table does not fit in fixed capacity container
+    if (result.size() != states * states) {
+        result.clear();
+        return;
     }
 
-    void dump (std::ostream & out, bool extended_data);
+    size_t row = 0;
+    size_t pos = 0;
 
-private:
-    std::vector<battery_extended> _batteries;
-    std::vector<ac_adapter>       _ac_adapters;
-    std::vector<thermal_zone>     _thermal_zones;
-    std::vector<fan>              _fans;
-};
+    while (pos < s.size() && row < states) {
+        auto eol = s.find('\n', pos);
 
-static std::string read_all (std::string const & path, bool remove_trailing_nl = false)
-{
-    auto input = fopen(path.c_str(), "r");
+        if (eol == std::string::npos)
+            eol = s.size();
 
-    if (!input)
-        return std::string{};
+        auto line = s.c_str() + pos;
+        pos = eol + 1;
+
+        unsigned int state = 0;
+        int n = 0;
+
+        if (sscanf(line, "state%u:%n", & state, & n) != 1 || n == 0)
+            continue;
+
+        auto p = line + n;
+
+        for (size_t col = 0; col < states; col++) {
+            unsigned long long value = 0;
+            int m = 0;
 
-    std::string result;
-    char buf[BUF_SZ];
-    int n = 0;
+            if (sscanf(p, "%llu%n", & value, & m) != 1)
+                break;
 
-    while ((n = fread(buf, 1, BUF_SZ, input))) {
-        if (remove_trailing_nl && n > 0 && n < BUF_SZ) {
-            if (buf[n - 1] == '\n')
-                --n;
+            result[row * states + col] = value;
+            p += m;
         }
 
-        result.append(buf, n);
+        ++row;
     }
-
-    fclose(input);
-    return result;
 }
 
-static int unit_value (std::string const & s)
+// Updates counters and deltas in place from `time_in_state_ms` and
+// `total_trans` content (the latter may be empty), vectors must be sized
+// to the number of states. Does not allocate memory.
+static void update_cooling_counters (char const * time_in_state
+    , char const * total_trans, bool has_prev, cooling_stats & stats)
 {
-    int n = -1;
-    sscanf(s.c_str(), "%d", & n);
-    return n;
+    size_t i = 0;
+
+    for_each_time_in_state(time_in_state, [& stats, & i, has_prev] (unsigned long long cur) {
+        if (i >= stats.time_in_state_ms.size())
+            return;
+
+        auto prev = stats.time_in_state_ms[i];
+
+        // Statistics may be reset by writing to `stats/reset`
+        stats.time_in_state_delta_ms[i] = !has_prev ? 0 : cur >= prev ? cur - prev : cur;
+        stats.time_in_state_ms[i] = cur;
+        ++i;
+    });
+
+    auto prev_total_trans = stats.total_trans;
+    stats.total_trans = *total_trans ? atoi(total_trans) : -1;
+    stats.trans_delta = 0;
+
+    if (has_prev && prev_total_trans >= 0 && stats.total_trans >= 0) {
+        stats.trans_delta = stats.total_trans >= prev_total_trans
+            ? stats.total_trans - prev_total_trans
+            : stats.total_trans;
+    }
 }
 
-bool starts_with (char const * s, char const * prefix)
+static size_t count_states (char const * time_in_state)
 {
-    while (*s && *prefix && *s++ == *prefix++)
-        ;
-    return *prefix == '\x0';
+    size_t states = 0;
+    for_each_time_in_state(time_in_state, [& states] (unsigned long long) { ++states; });
+    return states;
 }
 
-inline bool is_dir_entry (struct dirent * de)
+static void read_cooling_stats (std::string const & root_dir, cooling_stats & stats)
 {
-    return !strcmp(de->d_name, ".") || !strcmp(de->d_name, "..");
+    auto time_in_state = read_all(root_dir + "/stats/time_in_state_ms");
+
+    if (time_in_state.empty()) {
+        stats.total_trans = -1;
+        stats.trans_delta = 0;
+        stats.time_in_state_ms.clear();
+        stats.time_in_state_delta_ms.clear();
+        stats.trans_table.clear();
+        return;
+    }
+
+    // Previous values are used to calculate deltas
+    auto states = count_states(time_in_state.c_str());
+    bool has_prev = stats.time_in_state_ms.size() == states;
+
+    if (!has_prev)
+        stats.time_in_state_ms.assign(states, 0);
+
+    stats.time_in_state_delta_ms.assign(stats.time_in_state_ms.size(), 0);
+
+    auto total_trans = read_all(root_dir + "/stats/total_trans", true);
+    update_cooling_counters(time_in_state.c_str(), total_trans.c_str(), has_prev, stats);
+
+    // Transition table is not available if it exceeds PAGE_SIZE
+    parse_trans_table(read_all(root_dir + "/stats/trans_table"), states, stats.trans_table);
 }
 
-template <typename Visitor>
-void acquire_devices (char const * direntry, int devices, Visitor && visitor)
+// Updates cooling counters and deltas through cached attributes, the table
+// of transitions is updated by acquisition only
+template <typename Source>
+static void refresh_cooling_stats (Source const & src, cooling_stats & stats)
 {
-    auto d = ::opendir(direntry);
-
-    if (!d)
+    // Statistics are unavailable
+    if (stats.time_in_state_ms.empty())
         return;
 
-    struct dirent * de;
+    // Content of sysfs attribute does not exceed PAGE_SIZE
+    char time_in_state[4096];
+    char total_trans[BUF_SZ];
 
-    while ((de = ::readdir(d))) {
-        if (is_dir_entry(de))
-            continue;
+    if (!src.read(fan_time_in_state, time_in_state, sizeof(time_in_state)))
+        return;
 
-        visitor(de->d_name, devices);
-    }
+    if (count_states(time_in_state) != stats.time_in_state_ms.size())
+        return;
 
-    closedir(d);
+    if (!src.read(fan_total_trans, total_trans, sizeof(total_trans)))
+        total_trans[0] = '\x0';
+
+    update_cooling_counters(time_in_state, total_trans, true, stats);
 }
 
-void acpi::acquire_power_supply (int devices)
+// Parses ACPI 4.0 fan performance state:
+//      control:trip_point:speed_rpm:noise_level_mdb:power_mw
+// where any field except control may be `not-defined`.
+static bool parse_fan_performance_state (std::string const & s
+    , fan_performance_state & fps)
 {
-    if (devices & pfs::acpi::dev_battery)
-        _batteries.clear();
+    int * fields[] = {
+          & fps.control
+        , & fps.trip_point
+        , & fps.rpm
+        , & fps.noise_level
+        , & fps.power
+    };
 
-    if (devices & pfs::acpi::dev_ac_adapter)
-        _ac_adapters.clear();
+    auto p = s.c_str();
 
-    acquire_devices(ACPI_POWER_SUPPLY_PATH, devices, [this] (char const * direntry, int devices) {
-        bool is_battery = false;
-        bool is_ac_adapter = false;
+    for (auto field: fields) {
+        *field = -1;
 
-        std::string root_dir {ACPI_POWER_SUPPLY_PATH};
-        root_dir += '/';
-        root_dir += direntry;
+        if (!*p)
+            return false;
 
-        auto type = read_all(root_dir + "/type");
+        char * endptr = nullptr;
+        auto value = strtol(p, & endptr, 10);
 
-        if (type.empty())
-            return;
+        if (endptr != p)
+            *field = static_cast<int>(value);
 
-        if (strncasecmp(type.c_str(), "battery", 7) == 0)
-            is_battery = true;
-        else if (strncasecmp(type.c_str(), "mains", 5) == 0)
-            is_ac_adapter = true;
+        p = strchr(p, ':');
+        p = p ? p + 1 : s.c_str() + s.size();
+    }
 
-        if (is_battery && (devices & pfs::acpi::dev_battery)) {
-            _batteries.emplace_back();
-            auto & bat = _batteries.back();
-            bat.name = direntry;
+    return fps.control >= 0;
+}
 
-            bat.manufacturer = read_all(root_dir + "/manufacturer", true);
-            bat.model_name = read_all(root_dir + "/model_name", true);
-            bat.technology = read_all(root_dir + "/technology", true);
+// ACPI 4.0 fan performance states table is static, so it is read once
+static void read_performance_states (std::string const & root_dir, fan_extended & fan)
+{
+    if (!fan.performance_states.empty())
+        return;
 
-            auto charge_state = read_all(root_dir + "/status", true);
-            bat.charge_state = charge_state_enum::unknown;
+    std::string device_dir = root_dir + "/device/firmware_node";
+    fan.fine_grain_control = false;
 
-            if (strncasecmp(charge_state.c_str(), "disch", 5) == 0)
-                bat.charge_state = charge_state_enum::discharge;
-            else if (strncasecmp (charge_state.c_str(), "full", 4) == 0)
-                bat.charge_state = charge_state_enum::charged;
-            else if (strncasecmp (charge_state.c_str(), "chargi", 6) == 0)
-                bat.charge_state = charge_state_enum::charge;
+    for (int i = 0; ; i++) {
+        auto state = read_all(device_dir + "/state" + std::to_string(i), true);
 
-            ////////////////////////////////////////////////////////////////
-            auto remaining_capacity = read_all(root_dir + "/charge_now", true);
-            bat.remaining_capacity = -1;
+        if (state.empty())
+            break;
 
-            if (!remaining_capacity.empty())
-                bat.remaining_capacity = unit_value(remaining_capacity) / 1000;
+        fan_performance_state fps;
 
-            ////////////////////////////////////////////////////////////////
-            auto remaining_energy = read_all(root_dir + "/energy_now", true);
-            bat.remaining_energy = -1;
+        if (parse_fan_performance_state(state, fps))
+            fan.performance_states.push_back(fps);
+    }
 
-            if (!remaining_energy.empty())
-                bat.remaining_energy = unit_value(remaining_energy) / 1000;
+    if (fan.performance_states.empty())
+        return;
 
-            ////////////////////////////////////////////////////////////////
-            auto present_rate = read_all(root_dir + "/current_now", true);
-            bat.present_rate = -1;
+    auto fine_grain_control = read_all(device_dir + "/fine_grain_control", true);
+    fan.fine_grain_control = !fine_grain_control.empty() && unit_value(fine_grain_control) != 0;
+}
 
-            if (present_rate.empty())
-                present_rate = read_all(root_dir + "/power_now", true);
+template <typename Source>
+static void read_fan_values (Source const & src, fan_extended & fan)
+{
+    fan.cur_state = optional_value(src, fan_cur_state, 1);
+    fan.rpm = -1;
+    fan.power = -1;
 
-            if (!present_rate.empty())
-                bat.present_rate = unit_value(present_rate) / 1000;
+    // ACPI 4.0 fans only
+    if (fan.performance_states.empty())
+        return;
 
-            ////////////////////////////////////////////////////////////////
-            auto last_capacity = read_all(root_dir + "/charge_full", true);
-            bat.last_capacity = -1;
+    fan.rpm = optional_value(src, fan_speed_rpm, 1);
+
+    // Without fine grain control `cur_state` is an index in the performance
+    // states table, otherwise it is a percent of full speed, so the nearest
+    // state with control value not less than it is used
+    if (!fan.fine_grain_control) {
+        if (fan.cur_state >= 0 && fan.cur_state < fan.performance_states.size())
+            fan.power = fan.performance_states[fan.cur_state].power;
+    } else if (fan.cur_state >= 0) {
+        for (auto const & fps: fan.performance_states) {
+            if (fps.control >= fan.cur_state) {
+                fan.power = fps.power;
+                break;
+            }
+        }
+    }
+}
 
-            if (!last_capacity.empty())
-                bat.last_capacity = unit_value(last_capacity) / 1000;
+static void read_fan (std::string const & root_dir, fan_extended & fan)
+{
+    fan.type = read_all(root_dir + "/type", true);
 
-            ////////////////////////////////////////////////////////////////
-            auto last_capacity_unit = read_all(root_dir + "/energy_full", true);
-            bat.last_capacity_unit = -1;
+    auto max_state = read_all(root_dir + "/max_state");
+    fan.max_state = -1;
 
-            if (!last_capacity_unit.empty())
-                bat.last_capacity_unit = unit_value(last_capacity_unit) / 1000;
+    if (!max_state.empty())
+        fan.max_state = unit_value(max_state);
 
-            ////////////////////////////////////////////////////////////////
-            auto voltage = read_all(root_dir + "/voltage_now", true);
-            bat.voltage = -1;
+    read_performance_states(root_dir, fan);
+    read_fan_values(path_source{root_dir, FAN_ATTRS}, fan);
+    read_cooling_stats(root_dir, fan.stats);
+}
 
-            if (!voltage.empty())
-                bat.voltage = unit_value(voltage) / 1000;
+void acpi::acquire_power_supply (int devices)
+{
+    if (devices & pfs::acpi::dev_battery) {
+        _batteries.clear();
+        _battery_attrs.clear();
+    }
 
-            if (!bat.voltage)
-                bat.voltage = -1;
+    if (devices & pfs::acpi::dev_ac_adapter) {
+        _ac_adapters.clear();
+        _ac_adapter_attrs.clear();
+    }
 
-            ////////////////////////////////////////////////////////////////
-            // Recalculate attribute values
-            ////////////////////////////////////////////////////////////////
-            if (bat.last_capacity_unit != -1 && bat.last_capacity == -1) {
-                if (bat.voltage != -1) {
-                    bat.last_capacity = bat.last_capacity_unit * 1000 / bat.voltage;
-                } else {
-                    bat.last_capacity = bat.last_capacity_unit;
-                }
-            }
+    if (devices & pfs::acpi::dev_ups) {
+        _ups.clear();
+        _ups_attrs.clear();
+    }
 
-            if (bat.remaining_energy != -1 && bat.remaining_capacity == -1) {
-                if (bat.voltage != -1) {
-                    bat.remaining_capacity = bat.remaining_energy * 1000 / bat.voltage;
-                    bat.present_rate = bat.present_rate * 1000 / bat.voltage;
-                } else {
-                    bat.remaining_capacity = bat.remaining_energy;
-                }
-            }
+    if (devices & pfs::acpi::dev_usb_power_supply) {
+        _usb_power_supplies.clear();
+        _usb_power_supply_attrs.clear();
+    }
 
-            if (bat.last_capacity < MIN_CAPACITY)
-                bat.percentage = 0;
-            else
-                bat.percentage = bat.remaining_capacity * 100 / bat.last_capacity;
+    acquire_devices(_power_supply_path.c_str(), devices, [this] (char const * direntry, int devices) {
+        bool is_battery = false;
+        bool is_ac_adapter = false;
+        bool is_ups = false;
+        bool is_usb_power_supply = false;
 
-            if (bat.percentage > 100)
-                bat.percentage = 100;
+        std::string root_dir {_power_supply_path};
+        root_dir += '/';
+        root_dir += direntry;
 
-            bat.seconds = -1;
+        auto type = read_all(root_dir + "/type");
 
-            if (bat.present_rate == -1) {
-                bat.seconds = -1;
-            } else if (bat.charge_state == charge_state_enum::charge) {
-                if (bat.present_rate > MIN_PRESENT_RATE) {
-                    bat.seconds = 3600 * (bat.last_capacity - bat.remaining_capacity) / bat.present_rate;
-                } else {
-                    bat.seconds = -1; // charging at zero rate
-                }
-            } else if (bat.charge_state == charge_state_enum::discharge) {
-                if (bat.present_rate > MIN_PRESENT_RATE) {
-                    bat.seconds = 3600 * bat.remaining_capacity / bat.present_rate;
-                } else {
-                    bat.seconds = -1; //discharging at zero rate
-                }
-            } else {
-                bat.seconds = -1;
-            }
-        } else if (is_ac_adapter && (devices & pfs::acpi::dev_ac_adapter)) {
+        if (type.empty())
+            return;
+
+        if (strncasecmp(type.c_str(), "battery", 7) == 0)
+            is_battery = true;
+        else if (strncasecmp(type.c_str(), "mains", 5) == 0)
+            is_ac_adapter = true;
+        else if (strncasecmp(type.c_str(), "ups", 3) == 0)
+            is_ups = true;
+        else if (strncasecmp(type.c_str(), "usb", 3) == 0)
+            is_usb_power_supply = true;
+
+        if (is_battery && (devices & pfs::acpi::dev_battery) && has_room(_batteries)) {
+            _batteries.emplace_back();
+            auto & bat = _batteries.back();
+            bat.name = direntry;
+            bat.bus_id = read_bus_id(root_dir);
+            read_battery(root_dir, bat);
+            _battery_attrs.emplace_back();
+            _battery_attrs.back().open(root_dir, BATTERY_ATTRS, pfs::acpi::dev_battery);
+        } else if (is_ac_adapter && (devices & pfs::acpi::dev_ac_adapter) && has_room(_ac_adapters)) {
             _ac_adapters.emplace_back();
             auto & ac = _ac_adapters.back();
             ac.name = direntry;
-
-            auto online = read_all(root_dir + "/online", true);
-            ac.state = ac_state_enum::unknown;
-
-            if (!online.empty()) {
-                if (unit_value(online) == 0)
-                    ac.state = ac_state_enum::offline;
-                else
-                    ac.state = ac_state_enum::online;
-            }
+            ac.bus_id = read_bus_id(root_dir);
+            read_ac_adapter(root_dir, ac);
+            _ac_adapter_attrs.emplace_back();
+            _ac_adapter_attrs.back().open(root_dir, AC_ADAPTER_ATTRS, pfs::acpi::dev_ac_adapter);
+        } else if (is_ups && (devices & pfs::acpi::dev_ups) && has_room(_ups)) {
+            _ups.emplace_back();
+            auto & ups = _ups.back();
+            ups.name = direntry;
+            ups.bus_id = read_bus_id(root_dir);
+            read_ups(root_dir, ups);
+            _ups_attrs.emplace_back();
+            _ups_attrs.back().open(root_dir, UPS_ATTRS, pfs::acpi::dev_ups);
+        } else if (is_usb_power_supply && (devices & pfs::acpi::dev_usb_power_supply)
+                && has_room(_usb_power_supplies)) {
+            _usb_power_supplies.emplace_back();
+            auto & usb = _usb_power_supplies.back();
+            usb.name = direntry;
+            usb.bus_id = read_bus_id(root_dir);
+            read_usb_power_supply(root_dir, usb);
+            _usb_power_supply_attrs.emplace_back();
+            _usb_power_supply_attrs.back().open(root_dir, USB_POWER_SUPPLY_ATTRS, pfs::acpi::dev_usb_power_supply);
         }
     });
 }
 
 void acpi::acquire_thermal (int devices)
 {
-    if (devices & pfs::acpi::dev_thermal_zone)
-        _thermal_zones.clear();
+    // Keep previous thermal zones and fans to continue trend estimation
+    // and calculate statistics deltas
+    acpi_vector<thermal_zone_extended> prev_thermal_zones(allocator());
+    acpi_vector<fan_extended> prev_fans(allocator());
+
+    if (devices & pfs::acpi::dev_thermal_zone) {
+        prev_thermal_zones.swap(_thermal_zones);
+        _thermal_zone_attrs.clear();
+    }
 
-    if (devices & pfs::acpi::dev_fan)
-        _fans.clear();
+    if (devices & pfs::acpi::dev_fan) {
+        prev_fans.swap(_fans);
+        _fan_attrs.clear();
+    }
 
-    acquire_devices(ACPI_THERMAL_PATH, devices, [this] (char const * direntry, int devices) {
+    acquire_devices(_thermal_path.c_str(), devices, [this, & prev_thermal_zones, & prev_fans] (char const * direntry, int devices) {
         bool is_thermal_zone = false;
         bool is_fan = false;
 
-        std::string root_dir {ACPI_THERMAL_PATH};
+        std::string root_dir {_thermal_path};
         root_dir += '/';
         root_dir += direntry;
 
@@ -352,37 +1380,139 @@ void acpi::acquire_thermal (int devices)
         else
             is_thermal_zone = true;
 
-        if (is_thermal_zone && (devices & pfs::acpi::dev_thermal_zone)) {
+        if (is_thermal_zone && (devices & pfs::acpi::dev_thermal_zone) && has_room(_thermal_zones)) {
             _thermal_zones.emplace_back();
             auto & tz = _thermal_zones.back();
             tz.name = direntry;
+            tz.bus_id = read_bus_id(root_dir);
+
+            for (auto & prev: prev_thermal_zones) {
+                if (prev.name == tz.name) {
+                    tz.trip_points_acquired = prev.trip_points_acquired;
+                    tz.history = prev.history;
+                    tz.trend = prev.trend;
+                    break;
+                }
+            }
 
-            auto temperature = read_all(root_dir + "/temp");
-            tz.temperature = -1;
-
-            if (!temperature.empty())
-                tz.temperature = unit_value(temperature) / float{1000.0};
-        } else if (is_fan && (devices & pfs::acpi::dev_fan)) {
+            read_thermal_zone(root_dir, tz);
+            _thermal_zone_attrs.emplace_back();
+            _thermal_zone_attrs.back().open(root_dir, THERMAL_ZONE_ATTRS, pfs::acpi::dev_thermal_zone);
+        } else if (is_fan && (devices & pfs::acpi::dev_fan) && has_room(_fans)) {
             _fans.emplace_back();
             auto & fan = _fans.back();
             fan.name = direntry;
+            fan.bus_id = read_bus_id(root_dir);
+
+            for (auto & prev: prev_fans) {
+                if (prev.name == fan.name) {
+                    fan.stats = std::move(prev.stats);
+                    fan.performance_states = std::move(prev.performance_states);
+                    fan.fine_grain_control = prev.fine_grain_control;
+                    break;
+                }
+            }
+
+            fan.stats.name = direntry;
+            read_fan(root_dir, fan);
+            _fan_attrs.emplace_back();
+            _fan_attrs.back().open(root_dir, FAN_ATTRS, pfs::acpi::dev_fan);
+        }
+    });
+}
 
-            auto cur_state = read_all(root_dir + "/cur_state");
-            fan.cur_state = -1;
+void acpi::refresh (int devices)
+{
+    if (devices & pfs::acpi::dev_battery) {
+        for (size_t i = 0; i < _batteries.size(); i++)
+            read_battery_values(_battery_attrs[i], _batteries[i]);
+    }
 
-            if (!cur_state.empty())
-                fan.cur_state = unit_value(cur_state);
+    if (devices & pfs::acpi::dev_ac_adapter) {
+        for (size_t i = 0; i < _ac_adapters.size(); i++)
+            read_ac_adapter_values(_ac_adapter_attrs[i], _ac_adapters[i]);
+    }
 
-            auto max_state = read_all(root_dir + "/max_state");
-            fan.max_state = -1;
+    if (devices & pfs::acpi::dev_ups) {
+        for (size_t i = 0; i < _ups.size(); i++)
+            read_ups_values(_ups_attrs[i], _ups[i]);
+    }
 
-            if (!max_state.empty())
-                fan.max_state = unit_value(max_state);
+    if (devices & pfs::acpi::dev_usb_power_supply) {
+        for (size_t i = 0; i < _usb_power_supplies.size(); i++)
+            read_usb_power_supply_values(_usb_power_supply_attrs[i], _usb_power_supplies[i]);
+    }
 
+    if (devices & pfs::acpi::dev_thermal_zone) {
+        for (size_t i = 0; i < _thermal_zones.size(); i++) {
+            read_temperature(_thermal_zone_attrs[i], _thermal_zones[i]);
+            update_thermal_trend(_thermal_zones[i]);
         }
-    });
+    }
+
+    if (devices & pfs::acpi::dev_fan) {
+        for (size_t i = 0; i < _fans.size(); i++) {
+            read_fan_values(_fan_attrs[i], _fans[i]);
+            refresh_cooling_stats(_fan_attrs[i], _fans[i].stats);
+        }
+    }
+}
+
+template <typename Device, typename Reader>
+static bool refresh_bound_devices (acpi_vector<Device> & devices
+    , char const * class_path
+    , std::string const & bus_id
+    , Reader && reader)
+{
+    bool found = false;
+
+    for (auto & dev: devices) {
+        if (dev.bus_id.compare(bus_id.c_str()) != 0)
+            continue;
+
+        std::string root_dir {class_path};
+        root_dir += '/';
+        root_dir += dev.name.c_str();
+        reader(root_dir, dev);
+        found = true;
+    }
+
+    return found;
+}
+
+bool acpi::refresh_power_supply (int devices, std::string const & bus_id)
+{
+    bool found = false;
+
+    if (devices & pfs::acpi::dev_battery)
+        found = refresh_bound_devices(_batteries, _power_supply_path.c_str(), bus_id, read_battery) || found;
+
+    if (devices & pfs::acpi::dev_ac_adapter)
+        found = refresh_bound_devices(_ac_adapters, _power_supply_path.c_str(), bus_id, read_ac_adapter) || found;
+
+    if (devices & pfs::acpi::dev_ups)
+        found = refresh_bound_devices(_ups, _power_supply_path.c_str(), bus_id, read_ups) || found;
+
+    if (devices & pfs::acpi::dev_usb_power_supply)
+        found = refresh_bound_devices(_usb_power_supplies, _power_supply_path.c_str(), bus_id, read_usb_power_supply) || found;
+
+    return found;
+}
+
+bool acpi::refresh_thermal (int devices, std::string const & bus_id)
+{
+    bool found = false;
+
+    if (devices & pfs::acpi::dev_thermal_zone)
+        found = refresh_bound_devices(_thermal_zones, _thermal_path.c_str(), bus_id, read_thermal_zone) || found;
+
+    if (devices & pfs::acpi::dev_fan)
+        found = refresh_bound_devices(_fans, _thermal_path.c_str(), bus_id, read_fan) || found;
+
+    return found;
 }
 
+#if !PFS_ACPI_FIXED_CAPACITY
 void acpi::dump (std::ostream & out, bool extended_data)
 {
     out << "Batteries available: " << batteries_available() << "\n";
@@ -436,6 +1566,36 @@ void acpi::dump (std::ostream & out, bool extended_data)
         out << "\tstatus: " << to_string(ac.state) << "\n";
     }
 
+    out << "UPS available: " << ups_available() << "\n";
+
+    for (int i = 0; i < _ups.size(); i++) {
+        auto const & ups = _ups[i];
+        out << "UPS " << i << "\n";
+        out << "\tname        : " << ups.name << "\n";
+        out << "\tmanufacturer: " << ups.manufacturer << "\n";
+        out << "\tmodel name  : " << ups.model_name << "\n";
+        out << "\tmains       : " << to_string(ups.state) << "\n";
+        out << "\tstatus      : " << to_string(ups.charge_state) << "\n";
+        out << "\tpercentage  : " << ups.percentage << "\n";
+        out << "\tseconds     : " << ups.seconds << "\n";
+        out << "\tpower       : " << ups.power << " mW\n";
+    }
+
+    out << "USB power supplies available: " << usb_power_supplies_available() << "\n";
+
+    for (int i = 0; i < _usb_power_supplies.size(); i++) {
+        auto const & usb = _usb_power_supplies[i];
+        out << "USB power supply " << i << "\n";
+        out << "\tname               : " << usb.name << "\n";
+        out << "\ttype               : " << usb.type << "\n";
+        out << "\tUSB type           : " << usb.usb_type << "\n";
+        out << "\tstatus             : " << to_string(usb.state) << "\n";
+        out << "\tvoltage            : " << usb.voltage << " mV\n";
+        out << "\tcurrent max        : " << usb.current_max << " mA\n";
+        out << "\tinput current limit: " << usb.input_current_limit << " mA\n";
+        out << "\tinput power        : " << usb.input_power << " mW\n";
+    }
+
     out << "Thermal zones available: " << thermal_zones_available() << "\n";
 
     for (int i = 0; i < _thermal_zones.size(); i++) {
@@ -443,6 +1603,14 @@ void acpi::dump (std::ostream & out, bool extended_data)
         out << "Thermal zone " << i << "\n";
         out << "\tname       : " << tz.name << "\n";
         out << "\ttemperature: " << tz.temperature << " degrees Celsius\n";
+
+        if (extended_data) {
+            auto const & trend = _thermal_zones[i].trend;
+            out << "\tpassive    : " << trend.passive_temperature << " degrees Celsius\n";
+            out << "\tcritical   : " << trend.critical_temperature << " degrees Celsius\n";
+            out << "\tslope      : " << trend.slope << " degrees Celsius per second\n";
+            out << "\tto passive : " << trend.seconds_to_passive << " seconds\n";
+        }
     }
 
     out << "Fans (cooling devices) available: " << fans_available() << "\n";
@@ -451,18 +1619,83 @@ void acpi::dump (std::ostream & out, bool extended_data)
         auto const & fan = _fans[i];
         out << "Fan (Cooling device) " << i << "\n";
         out << "\tname       : " << fan.name << "\n";
+        out << "\ttype       : " << fan.type << "\n";
         out << "\tcur state  : " << fan.cur_state << "\n";
         out << "\tmax state  : " << fan.max_state << "\n";
+
+        if (!fan.performance_states.empty()) {
+            out << "\tspeed      : " << fan.rpm << " RPM\n";
+            out << "\tpower      : " << fan.power << " mW\n";
+            out << "\tfine grain : " << (fan.fine_grain_control ? "yes" : "no") << "\n";
+
+            if (extended_data) {
+                for (int j = 0; j < fan.performance_states.size(); j++) {
+                    auto const & fps = fan.performance_states[j];
+                    out << "\tperformance state " << j
+                        << ": control: " << fps.control
+                        << ", speed: " << fps.rpm << " RPM"
+                        << ", noise level: " << fps.noise_level
+                        << ", power: " << fps.power << " mW\n";
+                }
+            }
+        }
+
+        if (extended_data && fan.stats.total_trans >= 0) {
+            out << "\ttransitions: " << fan.stats.total_trans
+                << " (+" << fan.stats.trans_delta << ")\n";
+
+            for (int j = 0; j < fan.stats.time_in_state_ms.size(); j++) {
+                out << "\tstate " << j << "    : "
+                    << fan.stats.time_in_state_ms[j] << " ms (+"
+                    << fan.stats.time_in_state_delta_ms[j] << " ms)\n";
+            }
+        }
     }
 }
+#endif
 
 } // namespace details
 
+#if PFS_ACPI_PMR
+acpi::acpi ()
+{
+    _d.reset(new details::acpi(std::pmr::get_default_resource()));
+}
+
+acpi::acpi (std::pmr::memory_resource * mr)
+{
+    _d.reset(new details::acpi(mr));
+}
+
+acpi::acpi (std::string const & sysfs_root)
+{
+    _d.reset(new details::acpi(std::pmr::get_default_resource()));
+    _d->set_sysfs_root(sysfs_root);
+}
+
+acpi::acpi (std::string const & sysfs_root, std::pmr::memory_resource * mr)
+{
+    _d.reset(new details::acpi(mr));
+    _d->set_sysfs_root(sysfs_root);
+}
+
+std::pmr::memory_resource * acpi::resource () const
+{
+    return _d->resource();
+}
+#else
 acpi::acpi ()
 {
     _d.reset(new details::acpi);
 }
 
+acpi::acpi (std::string const & sysfs_root)
+{
+    _d.reset(new details::acpi);
+    _d->set_sysfs_root(sysfs_root);
+}
+#endif
+
 acpi::~acpi()
 {}
 
@@ -479,13 +1712,48 @@ bool acpi::has_acpi_support ()
 
 void acpi::acquire (int devices)
 {
-    // Acquire batteries and AC adapaters
-    if ((devices & dev_battery) || (devices & dev_ac_adapter))
+    // Acquire batteries, AC adapaters, UPS and USB power supplies
+    if (devices & dev_power_supply)
         _d->acquire_power_supply(devices);
 
     // Acquire thermal zones and fans
-    if ((devices & dev_thermal_zone) || (devices & dev_fan))
+    if (devices & dev_thermal)
         _d->acquire_thermal(devices);
+
+    _d->next_generation();
+    _d->next_acquisition_generation();
+}
+
+void acpi::refresh (int devices)
+{
+    _d->refresh(devices);
+    _d->next_generation();
+}
+
+void acpi::acquire (int devices, std::string const & bus_id)
+{
+    int missed = dev_none;
+
+    if (devices & dev_power_supply) {
+        int power_supply_devices = devices & dev_power_supply;
+
+        if (!_d->refresh_power_supply(power_supply_devices, bus_id))
+            missed |= power_supply_devices;
+    }
+
+    if (devices & dev_thermal) {
+        int thermal_devices = devices & dev_thermal;
+
+        if (!_d->refresh_thermal(thermal_devices, bus_id))
+            missed |= thermal_devices;
+    }
+
+    // Device is not acquired yet (e.g. battery was inserted), so acquire
+    // the whole class
+    if (missed != dev_none)
+        acquire(missed);
+    else
+        _d->next_generation();
 }
 
 size_t acpi::batteries_available () const
@@ -498,6 +1766,16 @@ size_t acpi::ac_adapters_available () const
     return _d->ac_adapters_available();
 }
 
+size_t acpi::ups_available () const
+{
+    return _d->ups_available();
+}
+
+size_t acpi::usb_power_supplies_available () const
+{
+    return _d->usb_power_supplies_available();
+}
+
 size_t acpi::thermal_zones_available () const
 {
     return _d->thermal_zones_available();
@@ -518,19 +1796,84 @@ ac_adapter acpi::ac_adapter_at (int index) const
     return _d->ac_adapter_at(index);
 }
 
+ups acpi::ups_at (int index) const
+{
+    return _d->ups_at(index);
+}
+
+usb_power_supply acpi::usb_power_supply_at (int index) const
+{
+    return _d->usb_power_supply_at(index);
+}
+
 thermal_zone acpi::thermal_zone_at (int index) const
 {
     return _d->thermal_zone_at(index);
 }
 
+thermal_trend acpi::thermal_trend_at (int index) const
+{
+    return _d->thermal_trend_at(index);
+}
+
+size_t acpi::thermal_zones_soa (std::int32_t * millidegrees
+    , std::int64_t * timestamps_ns
+    , std::uint64_t * valid
+    , size_t capacity) const
+{
+    return _d->thermal_zones_soa(millidegrees, timestamps_ns, valid, capacity);
+}
+
+acpi_vector<acpi_string> acpi::thermal_zone_names () const
+{
+    return _d->thermal_zone_names();
+}
+
+std::uint64_t acpi::generation () const
+{
+    return _d->generation();
+}
+
+std::uint64_t acpi::acquisition_generation () const
+{
+    return _d->acquisition_generation();
+}
+
+copy_result acpi::temperatures (float * out, size_t capacity) const
+{
+    return _d->temperatures(out, capacity);
+}
+
+copy_result acpi::battery_percentages (int * out, size_t capacity) const
+{
+    return _d->battery_percentages(out, capacity);
+}
+
+copy_result acpi::battery_rates (int * out, size_t capacity) const
+{
+    return _d->battery_rates(out, capacity);
+}
+
+copy_result acpi::fan_states (int * cur_states, int * max_states, size_t capacity) const
+{
+    return _d->fan_states(cur_states, max_states, capacity);
+}
+
 fan acpi::fan_at (int index) const
 {
     return _d->fan_at(index);
 }
 
+cooling_stats acpi::cooling_stats_at (int index) const
+{
+    return _d->cooling_stats_at(index);
+}
+
+#if !PFS_ACPI_FIXED_CAPACITY
 void acpi::dump (std::ostream & out, bool extended_data)
 {
     _d->dump(out, extended_data);
 }
+#endif
 
 } // namespace pfs
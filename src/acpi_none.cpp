@@ -13,6 +13,9 @@ namespace pfs {
 acpi::acpi ()
 {}
 
+acpi::acpi (std::string const & /*sysfs_root*/)
+{}
+
 acpi::~acpi ()
 {}
 
@@ -24,6 +27,12 @@ bool acpi::has_acpi_support ()
 void acpi::acquire (int /*devices*/) const
 {}
 
+void acpi::acquire (int /*devices*/, std::string const & /*bus_id*/)
+{}
+
+void acpi::refresh (int /*devices*/)
+{}
+
 ac_state_enum acpi::ac_state () const
 {
     return ac_state_enum::unsupported;
@@ -39,6 +48,16 @@ size_t acpi::ac_adapters_available () const
     return 0;
 }
 
+size_t acpi::ups_available () const
+{
+    return 0;
+}
+
+size_t acpi::usb_power_supplies_available () const
+{
+    return 0;
+}
+
 size_t acpi::thermal_zones_available () const
 {
     return 0;
@@ -59,6 +78,16 @@ ac_adapter acpi::ac_adapter_at (int /*index*/) const
     return ac_adapter{};
 }
 
+ups acpi::ups_at (int /*index*/) const
+{
+    return ups{};
+}
+
+usb_power_supply acpi::usb_power_supply_at (int /*index*/) const
+{
+    return usb_power_supply{};
+}
+
 thermal_zone thermal_zone_at (int /*index*/) const
 {
     return thermal_zone{};
@@ -69,6 +98,62 @@ fan acpi::fan_at (int /*index*/) const
     return 0;
 }
 
+thermal_trend acpi::thermal_trend_at (int /*index*/) const
+{
+    return thermal_trend{};
+}
+
+size_t acpi::thermal_zones_soa (std::int32_t * /*millidegrees*/
+    , std::int64_t * /*timestamps_ns*/
+    , std::uint64_t * valid
+    , size_t capacity) const
+{
+    for (size_t i = 0; i < (capacity + 63) / 64; i++)
+        valid[i] = 0;
+
+    return 0;
+}
+
+acpi_vector<acpi_string> acpi::thermal_zone_names () const
+{
+    return acpi_vector<acpi_string>{};
+}
+
+std::uint64_t acpi::generation () const
+{
+    return 0;
+}
+
+std::uint64_t acpi::acquisition_generation () const
+{
+    return 0;
+}
+
+copy_result acpi::temperatures (float * /*out*/, size_t /*capacity*/) const
+{
+    return copy_result{0, 0};
+}
+
+copy_result acpi::battery_percentages (int * /*out*/, size_t /*capacity*/) const
+{
+    return copy_result{0, 0};
+}
+
+copy_result acpi::battery_rates (int * /*out*/, size_t /*capacity*/) const
+{
+    return copy_result{0, 0};
+}
+
+copy_result acpi::fan_states (int * /*cur_states*/, int * /*max_states*/, size_t /*capacity*/) const
+{
+    return copy_result{0, 0};
+}
+
+cooling_stats acpi::cooling_stats_at (int /*index*/) const
+{
+    return cooling_stats{};
+}
+
 void acpi::dump (std::ostream & /*out*/, bool /*extended_data*/)
 {}
 
@@ -86,11 +86,33 @@ public:
 
     void dump (std::ostream & out, bool extended_data);
 
+    std::uint64_t generation () const
+    {
+        return _generation;
+    }
+
+    void next_generation ()
+    {
+        ++_generation;
+    }
+
+    std::uint64_t acquisition_generation () const
+    {
+        return _acquisition_generation;
+    }
+
+    void next_acquisition_generation ()
+    {
+        ++_acquisition_generation;
+    }
+
 private:
     std::vector<battery_extended> _batteries;
     std::vector<ac_adapter>       _ac_adapters;
     std::vector<thermal_zone>     _thermal_zones;
     std::vector<fan>              _fans;
+    std::uint64_t                 _generation {0};
+    std::uint64_t                 _acquisition_generation {0};
 };
 
 void acpi::acquire_power_supply (int devices)
@@ -214,6 +236,11 @@ acpi::acpi ()
     _d.reset(new details::acpi);
 }
 
+acpi::acpi (std::string const & /*sysfs_root*/)
+{
+    _d.reset(new details::acpi);
+}
+
 acpi::~acpi()
 {}
 
@@ -231,6 +258,20 @@ void acpi::acquire (int devices)
     // Acquire thermal zones and fans
     if ((devices & dev_thermal_zone) || (devices & dev_fan))
         _d->acquire_thermal(devices);
+
+    _d->next_generation();
+    _d->next_acquisition_generation();
+}
+
+// There are no cached attributes, so devices are re-acquired
+void acpi::refresh (int devices)
+{
+    acquire(devices);
+}
+
+void acpi::acquire (int devices, std::string const & /*bus_id*/)
+{
+    acquire(devices);
 }
 
 size_t acpi::batteries_available () const
@@ -243,6 +284,16 @@ size_t acpi::ac_adapters_available () const
     return _d->ac_adapters_available();
 }
 
+size_t acpi::ups_available () const
+{
+    return 0;
+}
+
+size_t acpi::usb_power_supplies_available () const
+{
+    return 0;
+}
+
 size_t acpi::thermal_zones_available () const
 {
     return _d->thermal_zones_available();
@@ -263,6 +314,16 @@ ac_adapter acpi::ac_adapter_at (int index) const
     return _d->ac_adapter_at(index);
 }
 
+ups acpi::ups_at (int /*index*/) const
+{
+    return ups{};
+}
+
+usb_power_supply acpi::usb_power_supply_at (int /*index*/) const
+{
+    return usb_power_supply{};
+}
+
 thermal_zone acpi::thermal_zone_at (int index) const
 {
     return _d->thermal_zone_at(index);
@@ -273,6 +334,87 @@ fan acpi::fan_at (int index) const
     return _d->fan_at(index);
 }
 
+thermal_trend acpi::thermal_trend_at (int /*index*/) const
+{
+    return thermal_trend{};
+}
+
+size_t acpi::thermal_zones_soa (std::int32_t * /*millidegrees*/
+    , std::int64_t * /*timestamps_ns*/
+    , std::uint64_t * valid
+    , size_t capacity) const
+{
+    for (size_t i = 0; i < (capacity + 63) / 64; i++)
+        valid[i] = 0;
+
+    return 0;
+}
+
+acpi_vector<acpi_string> acpi::thermal_zone_names () const
+{
+    return acpi_vector<acpi_string>{};
+}
+
+std::uint64_t acpi::generation () const
+{
+    return _d->generation();
+}
+
+std::uint64_t acpi::acquisition_generation () const
+{
+    return _d->acquisition_generation();
+}
+
+copy_result acpi::temperatures (float * out, size_t capacity) const
+{
+    size_t n = 0;
+
+    for (; n < capacity && n < _d->thermal_zones_available(); n++)
+        out[n] = _d->thermal_zone_at(n).temperature;
+
+    return copy_result{n, _d->generation()};
+}
+
+copy_result acpi::battery_percentages (int * out, size_t capacity) const
+{
+    size_t n = 0;
+
+    for (; n < capacity && n < _d->batteries_available(); n++)
+        out[n] = _d->battery_at(n).percentage;
+
+    return copy_result{n, _d->generation()};
+}
+
+copy_result acpi::battery_rates (int * out, size_t capacity) const
+{
+    size_t n = 0;
+
+    for (; n < capacity && n < _d->batteries_available(); n++)
+        out[n] = -1;
+
+    return copy_result{n, _d->generation()};
+}
+
+copy_result acpi::fan_states (int * cur_states, int * max_states, size_t capacity) const
+{
+    size_t n = 0;
+
+    for (; n < capacity && n < _d->fans_available(); n++) {
+        auto fan = _d->fan_at(n);
+        cur_states[n] = fan.cur_state;
+
+        if (max_states)
+            max_states[n] = fan.max_state;
+    }
+
+    return copy_result{n, _d->generation()};
+}
+
+cooling_stats acpi::cooling_stats_at (int /*index*/) const
+{
+    return cooling_stats{};
+}
+
 void acpi::dump (std::ostream & out, bool extended_data)
 {
     _d->dump(out, extended_data);
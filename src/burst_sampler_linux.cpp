@@ -0,0 +1,244 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026 Vladislav Trifochkin
+//
+// This file is part of [pfs-acpi](https://github.com/semenovf/pfs-acpi) library.
+//
+// Changelog:
+//      2026.10.17 Initial version
+//      2026.10.17 Invalid rate is rejected, rate is limited by `MAX_RATE`
+////////////////////////////////////////////////////////////////////////////////
+#include "pfs/acpi/burst_sampler.hpp"
+#include "sysfs.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <string>
+#include <vector>
+#include <time.h>
+
+namespace pfs {
+
+constexpr long long burst_sampler::INVALID_VALUE;
+constexpr double burst_sampler::MAX_RATE;
+
+static long long const NSEC_PER_SEC = 1000000000LL;
+
+namespace details {
+
+inline long long to_ns (struct timespec const & ts)
+{
+    return static_cast<long long>(ts.tv_sec) * NSEC_PER_SEC + ts.tv_nsec;
+}
+
+inline struct timespec to_timespec (long long ns)
+{
+    struct timespec ts;
+    ts.tv_sec = static_cast<time_t>(ns / NSEC_PER_SEC);
+    ts.tv_nsec = static_cast<long>(ns % NSEC_PER_SEC);
+    return ts;
+}
+
+inline long long now_ns ()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, & ts);
+    return to_ns(ts);
+}
+
+class burst_sampler
+{
+public:
+    int add_attribute (std::string const & path)
+    {
+        sysfs_attribute attr;
+
+        if (!attr.open(path))
+            return -1;
+
+        _attrs.push_back(std::move(attr));
+        _timestamps.clear();
+        _values.clear();
+        _count = 0;
+        return static_cast<int>(_attrs.size() - 1);
+    }
+
+    size_t attributes_count () const
+    {
+        return _attrs.size();
+    }
+
+    void reserve (size_t max_samples)
+    {
+        _timestamps.assign(max_samples, 0);
+        _values.assign(max_samples * _attrs.size(), pfs::burst_sampler::INVALID_VALUE);
+        _count = 0;
+    }
+
+    size_t capacity () const
+    {
+        return _timestamps.size();
+    }
+
+    size_t samples_count () const
+    {
+        return _count;
+    }
+
+    long long timestamp_at (size_t sample) const
+    {
+        return sample < _count ? _timestamps[sample] : 0;
+    }
+
+    long long value_at (size_t sample, int attribute) const
+    {
+        if (sample >= _count || attribute < 0 || attribute >= _attrs.size())
+            return pfs::burst_sampler::INVALID_VALUE;
+
+        return _values[sample * _attrs.size() + attribute];
+    }
+
+    burst_stats run (double rate_hz, int duration_ms, pfs::burst_sampler::wait_enum wait);
+
+private:
+    // Samples all attributes into the slot `index`, returns number of
+    // failed reads.
+    size_t sample (size_t index)
+    {
+        size_t errors = 0;
+        auto values = & _values[index * _attrs.size()];
+        _timestamps[index] = now_ns();
+
+        for (size_t i = 0; i < _attrs.size(); i++) {
+            long long value = 0;
+
+            if (_attrs[i].read_int(value)) {
+                values[i] = value;
+            } else {
+                values[i] = pfs::burst_sampler::INVALID_VALUE;
+                ++errors;
+            }
+        }
+
+        return errors;
+    }
+
+private:
+    std::vector<sysfs_attribute> _attrs;
+    std::vector<long long> _timestamps;
+    std::vector<long long> _values; // samples x attributes
+    size_t _count {0};
+};
+
+burst_stats burst_sampler::run (double rate_hz, int duration_ms
+    , pfs::burst_sampler::wait_enum wait)
+{
+    burst_stats stats {rate_hz, 0, 0, 0, 0, 0};
+    _count = 0;
+
+    // Also rejects NaN
+    if (!(rate_hz > 0)) {
+        stats.requested_rate = -1;
+        return stats;
+    }
+
+    if (duration_ms <= 0 || _timestamps.empty())
+        return stats;
+
+    auto period_ns = static_cast<long long>(NSEC_PER_SEC
+        / std::min(rate_hz, pfs::burst_sampler::MAX_RATE));
+    auto start = now_ns();
+    auto deadline = start + static_cast<long long>(duration_ms) * 1000000LL;
+    auto next = start;
+
+    while (_count < _timestamps.size() && next < deadline) {
+        if (wait == pfs::burst_sampler::wait_busy_poll) {
+            while (now_ns() < next)
+                ;
+        } else {
+            auto ts = to_timespec(next);
+
+            while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, & ts, nullptr) == EINTR)
+                ;
+        }
+
+        stats.read_errors += sample(_count);
+
+        if (_count > 0) {
+            auto interval = _timestamps[_count] - _timestamps[_count - 1];
+
+            if (interval > stats.max_interval_ns)
+                stats.max_interval_ns = interval;
+        }
+
+        ++_count;
+        next += period_ns;
+
+        // Skip missed deadlines instead of sampling back-to-back to catch up
+        auto now = now_ns();
+
+        if (next < now)
+            next += ((now - next) / period_ns + 1) * period_ns;
+    }
+
+    stats.samples = _count;
+
+    if (_count > 1) {
+        stats.duration_ns = _timestamps[_count - 1] - _timestamps[0];
+
+        if (stats.duration_ns > 0)
+            stats.achieved_rate = static_cast<double>(_count - 1) * NSEC_PER_SEC / stats.duration_ns;
+    }
+
+    return stats;
+}
+
+} // namespace details
+
+burst_sampler::burst_sampler ()
+{
+    _d.reset(new details::burst_sampler);
+}
+
+burst_sampler::~burst_sampler ()
+{}
+
+int burst_sampler::add_attribute (std::string const & path)
+{
+    return _d->add_attribute(path);
+}
+
+size_t burst_sampler::attributes_count () const
+{
+    return _d->attributes_count();
+}
+
+void burst_sampler::reserve (size_t max_samples)
+{
+    _d->reserve(max_samples);
+}
+
+size_t burst_sampler::capacity () const
+{
+    return _d->capacity();
+}
+
+burst_stats burst_sampler::run (double rate_hz, int duration_ms, wait_enum wait)
+{
+    return _d->run(rate_hz, duration_ms, wait);
+}
+
+size_t burst_sampler::samples_count () const
+{
+    return _d->samples_count();
+}
+
+long long burst_sampler::timestamp_at (size_t sample) const
+{
+    return _d->timestamp_at(sample);
+}
+
+long long burst_sampler::value_at (size_t sample, int attribute) const
+{
+    return _d->value_at(sample, attribute);
+}
+
+} // namespace pfs
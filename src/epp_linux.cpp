@@ -0,0 +1,375 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026 Vladislav Trifochkin
+//
+// This file is part of [pfs-acpi](https://github.com/semenovf/pfs-acpi) library.
+//
+// Changelog:
+//      2026.10.17 Initial version
+//      2026.10.17 Current value is re-read before write, raw values are restored
+////////////////////////////////////////////////////////////////////////////////
+#include "pfs/acpi/epp.hpp"
+#include "sysfs.hpp"
+#include <algorithm>
+#include <cctype>
+#include <string>
+#include <vector>
+
+//
+// [intel_pstate: Energy vs Performance Hints](https://docs.kernel.org/admin-guide/pm/intel_pstate.html#energy-vs-performance-hints)
+//
+
+namespace pfs {
+
+static char const * CPU_PATH = "/devices/system/cpu";
+static char const * EPP_ATTR = "/cpufreq/energy_performance_preference";
+static char const * EPP_AVAILABLE_ATTR = "/cpufreq/energy_performance_available_preferences";
+
+namespace details {
+
+struct cpu_epp_entry
+{
+    int cpu;
+    pfs::cpu_epp::code_type code; // last known value
+    sysfs_attribute attr;
+};
+
+class cpu_epp
+{
+public:
+    cpu_epp (std::string const & sysfs_root)
+        : _root_dir(sysfs_root + CPU_PATH)
+    {}
+
+    void discover ();
+
+    size_t cpus_available () const
+    {
+        return _entries.size();
+    }
+
+    int cpu_at (int index) const
+    {
+        if (index >= 0 && index < _entries.size())
+            return _entries[index].cpu;
+        return -1;
+    }
+
+    bool is_writable () const
+    {
+        return _writable;
+    }
+
+    std::vector<std::string> const & available_preferences () const
+    {
+        return _preferences;
+    }
+
+    pfs::cpu_epp::code_type code_of (char const * preference) const
+    {
+        for (size_t i = 0; i < _preferences.size(); i++) {
+            if (_preferences[i] == preference)
+                return static_cast<pfs::cpu_epp::code_type>(i);
+        }
+
+        return -1;
+    }
+
+    std::string preference_of (pfs::cpu_epp::code_type code) const
+    {
+        if (code >= 0 && code < _preferences.size())
+            return _preferences[code];
+        return std::string{};
+    }
+
+    bool read (std::vector<pfs::cpu_epp::code_type> & codes);
+    bool read_raw (std::vector<std::string> & values);
+    int apply (pfs::cpu_epp::code_type code);
+    int apply (std::vector<pfs::cpu_epp::code_type> const & codes);
+    int apply_raw (std::vector<std::string> const & values);
+
+private:
+    bool write (cpu_epp_entry & entry, pfs::cpu_epp::code_type code)
+    {
+        if (code < 0 || code >= _preferences.size())
+            return false;
+
+        return write(entry, _preferences[code]);
+    }
+
+    bool write (cpu_epp_entry & entry, std::string const & value)
+    {
+        char buf[BUF_SZ];
+
+        // Cached code may be stale (value changed by other tool), so
+        // current value is re-read: it is cheaper than writing EPP
+        if (entry.attr.read(buf, sizeof(buf)) >= 0) {
+            entry.code = code_of(buf);
+
+            if (value == buf)
+                return false;
+        }
+
+        if (!entry.attr.write(value))
+            return false;
+
+        entry.code = code_of(value.c_str());
+        return true;
+    }
+
+private:
+    std::string _root_dir;
+    std::vector<cpu_epp_entry> _entries;
+    std::vector<std::string> _preferences;
+    bool _writable {false};
+};
+
+static bool is_cpu_entry (char const * name)
+{
+    if (!starts_with(name, "cpu") || !name[3])
+        return false;
+
+    for (auto p = name + 3; *p; ++p) {
+        if (!isdigit(static_cast<unsigned char>(*p)))
+            return false;
+    }
+
+    return true;
+}
+
+void cpu_epp::discover ()
+{
+    _entries.clear();
+    _preferences.clear();
+    _writable = true;
+
+    acquire_devices(_root_dir.c_str(), 0, [this] (char const * direntry, int) {
+        if (!is_cpu_entry(direntry))
+            return;
+
+        std::string root_dir {_root_dir};
+        root_dir += '/';
+        root_dir += direntry;
+
+        cpu_epp_entry entry;
+        entry.cpu = atoi(direntry + 3);
+        entry.code = -1;
+
+        auto path = root_dir + EPP_ATTR;
+
+        if (!entry.attr.open(path, O_RDWR)) {
+            if (!entry.attr.open(path, O_RDONLY))
+                return;
+
+            _writable = false;
+        }
+
+        // Available preferences are the same for all CPUs
+        if (_preferences.empty()) {
+            auto available = read_all(root_dir + EPP_AVAILABLE_ATTR, true);
+            size_t pos = 0;
+
+            while (pos < available.size()) {
+                auto end = available.find(' ', pos);
+
+                if (end == std::string::npos)
+                    end = available.size();
+
+                if (end > pos)
+                    _preferences.emplace_back(available.substr(pos, end - pos));
+
+                pos = end + 1;
+            }
+        }
+
+        _entries.push_back(std::move(entry));
+    });
+
+    if (_entries.empty())
+        _writable = false;
+
+    std::sort(_entries.begin(), _entries.end()
+        , [] (cpu_epp_entry const & a, cpu_epp_entry const & b) {
+            return a.cpu < b.cpu;
+        });
+
+    std::vector<pfs::cpu_epp::code_type> codes;
+    read(codes);
+}
+
+bool cpu_epp::read (std::vector<pfs::cpu_epp::code_type> & codes)
+{
+    if (_entries.empty())
+        return false;
+
+    codes.resize(_entries.size());
+    char buf[BUF_SZ];
+
+    for (size_t i = 0; i < _entries.size(); i++) {
+        auto & entry = _entries[i];
+        entry.code = -1;
+
+        if (entry.attr.read(buf, sizeof(buf)) > 0)
+            entry.code = code_of(buf);
+
+        codes[i] = entry.code;
+    }
+
+    return true;
+}
+
+bool cpu_epp::read_raw (std::vector<std::string> & values)
+{
+    if (_entries.empty())
+        return false;
+
+    values.resize(_entries.size());
+    char buf[BUF_SZ];
+
+    for (size_t i = 0; i < _entries.size(); i++) {
+        auto & entry = _entries[i];
+        entry.code = -1;
+        values[i].clear();
+
+        if (entry.attr.read(buf, sizeof(buf)) > 0) {
+            entry.code = code_of(buf);
+            values[i] = buf;
+        }
+    }
+
+    return true;
+}
+
+int cpu_epp::apply (pfs::cpu_epp::code_type code)
+{
+    int count = 0;
+
+    for (auto & entry: _entries) {
+        if (write(entry, code))
+            ++count;
+    }
+
+    return count;
+}
+
+int cpu_epp::apply (std::vector<pfs::cpu_epp::code_type> const & codes)
+{
+    int count = 0;
+    auto n = std::min(codes.size(), _entries.size());
+
+    for (size_t i = 0; i < n; i++) {
+        if (write(_entries[i], codes[i]))
+            ++count;
+    }
+
+    return count;
+}
+
+int cpu_epp::apply_raw (std::vector<std::string> const & values)
+{
+    int count = 0;
+    auto n = std::min(values.size(), _entries.size());
+
+    for (size_t i = 0; i < n; i++) {
+        if (!values[i].empty() && write(_entries[i], values[i]))
+            ++count;
+    }
+
+    return count;
+}
+
+} // namespace details
+
+cpu_epp::cpu_epp ()
+    : cpu_epp("/sys")
+{}
+
+cpu_epp::cpu_epp (std::string const & sysfs_root)
+{
+    _d.reset(new details::cpu_epp(sysfs_root));
+}
+
+cpu_epp::~cpu_epp ()
+{}
+
+void cpu_epp::discover ()
+{
+    _d->discover();
+}
+
+size_t cpu_epp::cpus_available () const
+{
+    return _d->cpus_available();
+}
+
+int cpu_epp::cpu_at (int index) const
+{
+    return _d->cpu_at(index);
+}
+
+bool cpu_epp::is_writable () const
+{
+    return _d->is_writable();
+}
+
+std::vector<std::string> cpu_epp::available_preferences () const
+{
+    return _d->available_preferences();
+}
+
+cpu_epp::code_type cpu_epp::code_of (std::string const & preference) const
+{
+    return _d->code_of(preference.c_str());
+}
+
+std::string cpu_epp::preference_of (code_type code) const
+{
+    return _d->preference_of(code);
+}
+
+bool cpu_epp::read (std::vector<code_type> & codes) const
+{
+    return _d->read(codes);
+}
+
+int cpu_epp::apply (std::string const & preference)
+{
+    auto code = _d->code_of(preference.c_str());
+
+    if (code < 0)
+        return -1;
+
+    return _d->apply(code);
+}
+
+int cpu_epp::apply (std::vector<code_type> const & codes)
+{
+    return _d->apply(codes);
+}
+
+bool cpu_epp::read_raw (std::vector<std::string> & values) const
+{
+    return _d->read_raw(values);
+}
+
+int cpu_epp::apply_raw (std::vector<std::string> const & values)
+{
+    return _d->apply_raw(values);
+}
+
+scoped_cpu_epp::scoped_cpu_epp (cpu_epp & epp, std::string const & preference)
+    : _epp(epp)
+{
+    // Raw values are saved as numeric EPP values have no preference codes
+    if (!_epp.read_raw(_saved))
+        return;
+
+    _active = _epp.apply(preference) > 0;
+}
+
+scoped_cpu_epp::~scoped_cpu_epp ()
+{
+    if (_active)
+        _epp.apply_raw(_saved);
+}
+
+} // namespace pfs
@@ -0,0 +1,443 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026 Vladislav Trifochkin
+//
+// This file is part of [pfs-acpi](https://github.com/semenovf/pfs-acpi) library.
+//
+// Changelog:
+//      2026.10.17 Initial version
+//      2026.10.17 Device names are cached until the next acquisition
+////////////////////////////////////////////////////////////////////////////////
+#include "pfs/acpi/metrics_emitter.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <cstdarg>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <netdb.h>
+#include <time.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+namespace pfs {
+
+namespace details {
+
+// Metric line in stack buffer, longer lines are dropped
+struct metric_line
+{
+    static constexpr std::size_t CAPACITY = 512;
+
+    char data[CAPACITY];
+    std::size_t size {0};
+    bool overflow {false};
+
+    void clear ()
+    {
+        size = 0;
+        overflow = false;
+    }
+
+    void append (char const * format, ...)
+    {
+        if (overflow)
+            return;
+
+        va_list args;
+        va_start(args, format);
+        auto n = vsnprintf(data + size, CAPACITY - size, format, args);
+        va_end(args);
+
+        if (n < 0 || static_cast<std::size_t>(n) >= CAPACITY - size)
+            overflow = true;
+        else
+            size += static_cast<std::size_t>(n);
+    }
+
+    // Escapes commas, spaces and equal signs in line protocol tag value
+    void append_tag_value (char const * s, std::size_t n)
+    {
+        for (std::size_t i = 0; i < n && !overflow; i++) {
+            bool escape = s[i] == ',' || s[i] == ' ' || s[i] == '=';
+
+            if (size + (escape ? 2 : 1) > CAPACITY) {
+                overflow = true;
+                break;
+            }
+
+            if (escape)
+                data[size++] = '\\';
+
+            data[size++] = s[i];
+        }
+    }
+};
+
+constexpr std::size_t metric_line::CAPACITY;
+
+class metrics_emitter
+{
+public:
+    ~metrics_emitter ()
+    {
+        close();
+    }
+
+    bool open (emitter_options const & options)
+    {
+        close();
+
+        if (options.max_datagram_size < 64)
+            return false;
+
+        struct addrinfo hints;
+        std::memset(& hints, 0, sizeof(hints));
+        hints.ai_family = AF_UNSPEC;
+        hints.ai_socktype = SOCK_DGRAM;
+
+        struct addrinfo * result = nullptr;
+        auto port = std::to_string(options.port);
+
+        if (getaddrinfo(options.host.c_str(), port.c_str(), & hints, & result) != 0)
+            return false;
+
+        for (auto ai = result; ai != nullptr && _fd < 0; ai = ai->ai_next) {
+            _fd = socket(ai->ai_family, ai->ai_socktype | SOCK_CLOEXEC, ai->ai_protocol);
+
+            if (_fd >= 0 && connect(_fd, ai->ai_addr, ai->ai_addrlen) != 0) {
+                ::close(_fd);
+                _fd = -1;
+            }
+        }
+
+        freeaddrinfo(result);
+
+        if (_fd < 0)
+            return false;
+
+        _options = options;
+        _stats = emitter_stats{0, 0, 0, 0, 0};
+        return true;
+    }
+
+    void close ()
+    {
+        if (_fd >= 0) {
+            ::close(_fd);
+            _fd = -1;
+        }
+    }
+
+    bool is_open () const
+    {
+        return _fd >= 0;
+    }
+
+    int emit (pfs::acpi const & a)
+    {
+        if (_fd < 0)
+            return -1;
+
+        format(a);
+        return send() ? static_cast<int>(_records) : -1;
+    }
+
+    emitter_stats stats () const
+    {
+        return _stats;
+    }
+
+private:
+    void format (pfs::acpi const & a)
+    {
+        _used = 0;
+        _records = 0;
+        _datagram_ends.clear();
+
+        struct timespec ts;
+        clock_gettime(CLOCK_REALTIME, & ts);
+        _timestamp_ns = static_cast<long long>(ts.tv_sec) * 1000000000LL + ts.tv_nsec;
+
+        if (_options.devices & pfs::acpi::dev_battery) {
+            auto count = a.batteries_available();
+            _rates.resize(count);
+            count = a.battery_rates(_rates.data(), count).count;
+
+            for (size_t i = 0; i < count; i++) {
+                auto bat = a.battery_at(static_cast<int>(i));
+
+                begin("battery", bat.name.data(), bat.name.size());
+                field("percentage", bat.percentage);
+                field("seconds", bat.seconds);
+                field("rate", _rates[i]);
+                field("charge_state", static_cast<int>(bat.charge_state));
+                end();
+            }
+        }
+
+        if (_options.devices & pfs::acpi::dev_ac_adapter) {
+            for (size_t i = 0; i < a.ac_adapters_available(); i++) {
+                auto ac = a.ac_adapter_at(static_cast<int>(i));
+
+                begin("ac_adapter", ac.name.data(), ac.name.size());
+
+                if (ac.state != ac_state_enum::unknown)
+                    field("online", ac.state == ac_state_enum::online ? 1 : 0);
+
+                end();
+            }
+        }
+
+        if (_options.devices & pfs::acpi::dev_thermal_zone) {
+            auto count = a.thermal_zones_available();
+
+            // Names are cached until the next acquisition, refresh keeps them
+            if (_zone_names_generation != a.acquisition_generation() || _zone_names.size() != count) {
+                _zone_names_generation = a.acquisition_generation();
+                _zone_names.resize(count);
+
+                for (size_t i = 0; i < count; i++) {
+                    auto name = a.thermal_zone_at(static_cast<int>(i)).name;
+                    _zone_names[i].assign(name.data(), name.size());
+                }
+            }
+
+            _temperatures.resize(count);
+            count = a.temperatures(_temperatures.data(), count).count;
+
+            for (size_t i = 0; i < count; i++) {
+                begin("thermal_zone", _zone_names[i].data(), _zone_names[i].size());
+
+                if (_temperatures[i] != -1)
+                    field("temperature", _temperatures[i]);
+
+                end();
+            }
+        }
+
+        if (_options.devices & pfs::acpi::dev_fan) {
+            auto count = a.fans_available();
+
+            if (_fan_names_generation != a.acquisition_generation() || _fan_names.size() != count) {
+                _fan_names_generation = a.acquisition_generation();
+                _fan_names.resize(count);
+
+                for (size_t i = 0; i < count; i++) {
+                    auto name = a.fan_at(static_cast<int>(i)).name;
+                    _fan_names[i].assign(name.data(), name.size());
+                }
+            }
+
+            _cur_states.resize(count);
+            _max_states.resize(count);
+            count = a.fan_states(_cur_states.data(), _max_states.data(), count).count;
+
+            for (size_t i = 0; i < count; i++) {
+                begin("fan", _fan_names[i].data(), _fan_names[i].size());
+                field("cur_state", _cur_states[i]);
+                field("max_state", _max_states[i]);
+                end();
+            }
+        }
+
+        if (_used > 0 && (_datagram_ends.empty() || _datagram_ends.back() != _used))
+            _datagram_ends.push_back(_used);
+    }
+
+    void begin (char const * measurement, char const * device, std::size_t device_size)
+    {
+        _measurement = measurement;
+        _device = device;
+        _device_size = device_size;
+        _fields = 0;
+        _line.clear();
+
+        if (_options.format == emitter_options::format_influx) {
+            _line.append("%s_%s,device=", _options.prefix.c_str(), measurement);
+            _line.append_tag_value(device, device_size);
+
+            if (!_options.tags.empty())
+                _line.append(",%s", _options.tags.c_str());
+        }
+    }
+
+    // Unavailable (negative) integer values are omitted
+    void field (char const * name, int value)
+    {
+        if (value < 0)
+            return;
+
+        if (_options.format == emitter_options::format_influx) {
+            _line.append("%c%s=%di", _fields == 0 ? ' ' : ',', name, value);
+            ++_fields;
+        } else {
+            statsd_prefix(name);
+            _line.append("%d|g", value);
+            commit_line();
+        }
+    }
+
+    void field (char const * name, float value)
+    {
+        if (_options.format == emitter_options::format_influx) {
+            _line.append("%c%s=%g", _fields == 0 ? ' ' : ',', name, static_cast<double>(value));
+            ++_fields;
+        } else {
+            statsd_prefix(name);
+            _line.append("%g|g", static_cast<double>(value));
+            commit_line();
+        }
+    }
+
+    void end ()
+    {
+        if (_options.format == emitter_options::format_influx && _fields > 0) {
+            _line.append(" %lld", _timestamp_ns);
+            commit_line();
+        }
+    }
+
+    void statsd_prefix (char const * name)
+    {
+        _line.clear();
+        _line.append("%s.%s.%.*s.%s:", _options.prefix.c_str(), _measurement
+            , static_cast<int>(_device_size), _device, name);
+    }
+
+    // Appends line to the current datagram or starts the next one
+    void commit_line ()
+    {
+        _line.append("\n");
+
+        if (_line.overflow || _line.size > _options.max_datagram_size)
+            return;
+
+        auto start = _datagram_ends.empty() ? 0 : _datagram_ends.back();
+
+        if (_used - start + _line.size > _options.max_datagram_size)
+            _datagram_ends.push_back(_used);
+
+        // Buffer only grows, so it is reused by subsequent emits
+        if (_buffer.size() < _used + _line.size)
+            _buffer.resize(std::max(_buffer.size() * 2, _used + _line.size));
+
+        std::memcpy(_buffer.data() + _used, _line.data, _line.size);
+        _used += _line.size;
+        ++_records;
+    }
+
+    bool send ()
+    {
+        auto count = _datagram_ends.size();
+
+        if (count == 0)
+            return true;
+
+        _iov.resize(count);
+        _msgs.resize(count);
+
+        std::size_t start = 0;
+
+        for (std::size_t i = 0; i < count; i++) {
+            _iov[i].iov_base = _buffer.data() + start;
+            _iov[i].iov_len = _datagram_ends[i] - start;
+            std::memset(& _msgs[i], 0, sizeof(_msgs[i]));
+            _msgs[i].msg_hdr.msg_iov = & _iov[i];
+            _msgs[i].msg_hdr.msg_iovlen = 1;
+            start = _datagram_ends[i];
+        }
+
+        std::size_t sent = 0;
+
+        while (sent < count) {
+            auto n = sendmmsg(_fd, & _msgs[sent], static_cast<unsigned int>(count - sent), 0);
+            ++_stats.send_calls;
+
+            if (n < 0) {
+                if (errno == EINTR)
+                    continue;
+
+                // E.g. ECONNREFUSED while collector is not running
+                ++_stats.errors;
+                return false;
+            }
+
+            for (int i = 0; i < n; i++)
+                _stats.bytes += _msgs[sent + i].msg_len;
+
+            sent += static_cast<std::size_t>(n);
+        }
+
+        _stats.datagrams += count;
+        _stats.records += _records;
+        return true;
+    }
+
+private:
+    emitter_options _options;
+    int _fd {-1};
+    emitter_stats _stats {0, 0, 0, 0, 0};
+
+    // Reusable buffers
+    std::vector<char> _buffer;
+    std::vector<std::size_t> _datagram_ends;
+    std::vector<struct iovec> _iov;
+    std::vector<struct mmsghdr> _msgs;
+    std::vector<std::string> _zone_names;
+    std::vector<std::string> _fan_names;
+    std::uint64_t _zone_names_generation {UINT64_MAX};
+    std::uint64_t _fan_names_generation {UINT64_MAX};
+    std::vector<int> _rates;
+    std::vector<float> _temperatures;
+    std::vector<int> _cur_states;
+    std::vector<int> _max_states;
+
+    // Formatting state
+    metric_line _line;
+    std::size_t _used {0};
+    std::size_t _records {0};
+    long long _timestamp_ns {0};
+    char const * _measurement {nullptr};
+    char const * _device {nullptr};
+    std::size_t _device_size {0};
+    int _fields {0};
+};
+
+} // namespace details
+
+metrics_emitter::metrics_emitter ()
+{
+    _d.reset(new details::metrics_emitter);
+}
+
+metrics_emitter::~metrics_emitter ()
+{}
+
+bool metrics_emitter::open (emitter_options const & options)
+{
+    return _d->open(options);
+}
+
+void metrics_emitter::close ()
+{
+    _d->close();
+}
+
+bool metrics_emitter::is_open () const
+{
+    return _d->is_open();
+}
+
+int metrics_emitter::emit (acpi const & a)
+{
+    return _d->emit(a);
+}
+
+emitter_stats metrics_emitter::stats () const
+{
+    return _d->stats();
+}
+
+} // namespace pfs
@@ -0,0 +1,303 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026 Vladislav Trifochkin
+//
+// This file is part of [pfs-acpi](https://github.com/semenovf/pfs-acpi) library.
+//
+// Changelog:
+//      2026.10.17 Initial version
+////////////////////////////////////////////////////////////////////////////////
+#include "pfs/acpi/monitor_client.hpp"
+#include <cerrno>
+#include <cstring>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace pfs {
+
+namespace details {
+
+static size_t const RECV_BUF_SZ = 65536;
+
+class acpi_monitor_client
+{
+public:
+    ~acpi_monitor_client ()
+    {
+        close();
+    }
+
+    bool connect (std::string const & socket_path)
+    {
+        close();
+
+        struct sockaddr_un addr;
+        std::memset(& addr, 0, sizeof(addr));
+        addr.sun_family = AF_UNIX;
+
+        if (socket_path.size() >= sizeof(addr.sun_path))
+            return false;
+
+        socket_path.copy(addr.sun_path, socket_path.size());
+
+        _fd = socket(AF_UNIX, SOCK_SEQPACKET | SOCK_CLOEXEC, 0);
+
+        if (_fd < 0)
+            return false;
+
+        if (::connect(_fd, reinterpret_cast<struct sockaddr *>(& addr), sizeof(addr)) != 0) {
+            close();
+            return false;
+        }
+
+        _buffer.resize(RECV_BUF_SZ);
+        return true;
+    }
+
+    void close ()
+    {
+        if (_fd >= 0) {
+            ::close(_fd);
+            _fd = -1;
+        }
+    }
+
+    bool is_open () const
+    {
+        return _fd >= 0;
+    }
+
+    int native_handle () const
+    {
+        return _fd;
+    }
+
+    bool subscribe (std::uint32_t fields, std::uint32_t interval_ms)
+    {
+        monitor::subscribe_request req;
+        std::memset(& req, 0, sizeof(req));
+        req.header.type = monitor::msg_subscribe;
+        req.header.version = monitor::PROTOCOL_VERSION;
+        req.fields = fields;
+        req.interval_ms = interval_ms;
+
+        return _fd >= 0 && send(_fd, & req, sizeof(req), MSG_NOSIGNAL) == sizeof(req);
+    }
+
+    int receive (int timeout_ms)
+    {
+        if (_fd < 0)
+            return -1;
+
+        struct pollfd pfd;
+        pfd.fd = _fd;
+        pfd.events = POLLIN;
+
+        int rc = 0;
+
+        do {
+            rc = poll(& pfd, 1, timeout_ms);
+        } while (rc < 0 && errno == EINTR);
+
+        if (rc <= 0)
+            return rc;
+
+        auto n = recv(_fd, _buffer.data(), _buffer.size(), 0);
+
+        // Zero is end of connection
+        if (n <= 0)
+            return -1;
+
+        auto size = static_cast<size_t>(n);
+
+        if (size < sizeof(monitor::message_header))
+            return -1;
+
+        monitor::message_header header;
+        std::memcpy(& header, _buffer.data(), sizeof(header));
+
+        if (header.version != monitor::PROTOCOL_VERSION)
+            return -1;
+
+        switch (header.type) {
+            case monitor::msg_names:
+                return apply_names(header.count, size) ? monitor::msg_names : -1;
+            case monitor::msg_delta:
+                return apply_delta(header.count, size) ? monitor::msg_delta : -1;
+            default:
+                break;
+        }
+
+        return -1;
+    }
+
+    std::vector<monitor::delta_entry> const & changes () const
+    {
+        return _changes;
+    }
+
+    std::uint64_t generation () const
+    {
+        return _generation;
+    }
+
+    size_t devices_count (monitor::device_class_enum device_class) const
+    {
+        return device_class < monitor::class_count ? _names[device_class].size() : 0;
+    }
+
+    std::string device_name (monitor::device_class_enum device_class, int index) const
+    {
+        if (device_class < monitor::class_count && index >= 0
+                && static_cast<size_t>(index) < _names[device_class].size()) {
+            return _names[device_class][index];
+        }
+
+        return std::string{};
+    }
+
+    std::int32_t value (monitor::field_enum field, int index) const
+    {
+        if (field < monitor::field_count && index >= 0
+                && static_cast<size_t>(index) < _values[field].size()) {
+            return _values[field][index];
+        }
+
+        return monitor::VALUE_UNAVAILABLE;
+    }
+
+private:
+    bool apply_names (std::uint32_t count, size_t size)
+    {
+        if (size != sizeof(monitor::message_header) + count * sizeof(monitor::name_entry))
+            return false;
+
+        for (auto & names: _names)
+            names.clear();
+
+        auto p = _buffer.data() + sizeof(monitor::message_header);
+
+        for (std::uint32_t i = 0; i < count; i++, p += sizeof(monitor::name_entry)) {
+            monitor::name_entry entry;
+            std::memcpy(& entry, p, sizeof(entry));
+
+            if (entry.device_class >= monitor::class_count)
+                continue;
+
+            auto & names = _names[entry.device_class];
+
+            if (names.size() <= entry.index)
+                names.resize(entry.index + 1);
+
+            names[entry.index].assign(entry.name, strnlen(entry.name, sizeof(entry.name)));
+        }
+
+        // Values are resent by the next delta
+        for (int f = 0; f < monitor::field_count; f++) {
+            auto field = static_cast<monitor::field_enum>(f);
+            _values[f].assign(_names[monitor::class_of(field)].size(), monitor::VALUE_UNAVAILABLE);
+        }
+
+        return true;
+    }
+
+    bool apply_delta (std::uint32_t count, size_t size)
+    {
+        if (size != sizeof(monitor::delta_header) + count * sizeof(monitor::delta_entry))
+            return false;
+
+        monitor::delta_header header;
+        std::memcpy(& header, _buffer.data(), sizeof(header));
+        _generation = header.generation;
+
+        _changes.resize(count);
+
+        if (count > 0) {
+            std::memcpy(_changes.data(), _buffer.data() + sizeof(monitor::delta_header)
+                , count * sizeof(monitor::delta_entry));
+        }
+
+        for (auto const & entry: _changes) {
+            if (entry.field < monitor::field_count && entry.index < _values[entry.field].size())
+                _values[entry.field][entry.index] = entry.value;
+        }
+
+        return true;
+    }
+
+private:
+    int _fd {-1};
+    std::vector<char> _buffer;
+    std::vector<std::string> _names[monitor::class_count];
+    std::vector<std::int32_t> _values[monitor::field_count];
+    std::vector<monitor::delta_entry> _changes;
+    std::uint64_t _generation {0};
+};
+
+} // namespace details
+
+acpi_monitor_client::acpi_monitor_client ()
+{
+    _d.reset(new details::acpi_monitor_client);
+}
+
+acpi_monitor_client::~acpi_monitor_client ()
+{}
+
+bool acpi_monitor_client::connect (std::string const & socket_path)
+{
+    return _d->connect(socket_path);
+}
+
+void acpi_monitor_client::close ()
+{
+    _d->close();
+}
+
+bool acpi_monitor_client::is_open () const
+{
+    return _d->is_open();
+}
+
+int acpi_monitor_client::native_handle () const
+{
+    return _d->native_handle();
+}
+
+bool acpi_monitor_client::subscribe (std::uint32_t fields, std::uint32_t interval_ms)
+{
+    return _d->subscribe(fields, interval_ms);
+}
+
+int acpi_monitor_client::receive (int timeout_ms)
+{
+    return _d->receive(timeout_ms);
+}
+
+std::vector<monitor::delta_entry> const & acpi_monitor_client::changes () const
+{
+    return _d->changes();
+}
+
+std::uint64_t acpi_monitor_client::generation () const
+{
+    return _d->generation();
+}
+
+size_t acpi_monitor_client::devices_count (monitor::device_class_enum device_class) const
+{
+    return _d->devices_count(device_class);
+}
+
+std::string acpi_monitor_client::device_name (monitor::device_class_enum device_class, int index) const
+{
+    return _d->device_name(device_class, index);
+}
+
+std::int32_t acpi_monitor_client::value (monitor::field_enum field, int index) const
+{
+    return _d->value(field, index);
+}
+
+} // namespace pfs
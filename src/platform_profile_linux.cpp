@@ -0,0 +1,180 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026 Vladislav Trifochkin
+//
+// This file is part of [pfs-acpi](https://github.com/semenovf/pfs-acpi) library.
+//
+// Changelog:
+//      2026.10.17 Initial version
+////////////////////////////////////////////////////////////////////////////////
+#include "pfs/acpi/platform_profile.hpp"
+#include "sysfs.hpp"
+#include <algorithm>
+#include <string>
+#include <vector>
+
+//
+// [Platform Profile Selection](https://docs.kernel.org/userspace-api/sysfs-platform_profile.html)
+//
+
+namespace pfs {
+
+static char const * ACPI_PLATFORM_PROFILE_PATH = "/firmware/acpi/platform_profile";
+static char const * ACPI_PLATFORM_PROFILE_CHOICES_PATH = "/firmware/acpi/platform_profile_choices";
+
+namespace details {
+
+class platform_profile
+{
+public:
+    platform_profile (std::string const & sysfs_root)
+    {
+        auto choices = read_all(sysfs_root + ACPI_PLATFORM_PROFILE_CHOICES_PATH, true);
+        size_t pos = 0;
+
+        // Choices are separated by spaces
+        while (pos < choices.size()) {
+            auto end = choices.find(' ', pos);
+
+            if (end == std::string::npos)
+                end = choices.size();
+
+            if (end > pos)
+                _choices.emplace_back(choices.substr(pos, end - pos));
+
+            pos = end + 1;
+        }
+
+        auto path = sysfs_root + ACPI_PLATFORM_PROFILE_PATH;
+
+        if (!_profile_attr.open(path, O_RDWR))
+            _profile_attr.open(path, O_RDONLY);
+
+        refresh();
+    }
+
+    bool is_supported () const
+    {
+        return _profile_attr.is_open();
+    }
+
+    std::vector<std::string> const & choices () const
+    {
+        return _choices;
+    }
+
+    bool has_choice (std::string const & profile) const
+    {
+        return std::find(_choices.begin(), _choices.end(), profile) != _choices.end();
+    }
+
+    std::string const & current () const
+    {
+        return _current;
+    }
+
+    int native_handle () const
+    {
+        return _profile_attr.native_handle();
+    }
+
+    bool refresh ()
+    {
+        char buf[BUF_SZ];
+
+        if (_profile_attr.read(buf, sizeof(buf)) < 0)
+            return false;
+
+        if (_current == buf)
+            return false;
+
+        _current = buf;
+        return true;
+    }
+
+    bool set (std::string const & profile)
+    {
+        if (!has_choice(profile))
+            return false;
+
+        if (!_profile_attr.write(profile))
+            return false;
+
+        _current = profile;
+        return true;
+    }
+
+private:
+    sysfs_attribute _profile_attr;
+    std::vector<std::string> _choices;
+    std::string _current;
+};
+
+} // namespace details
+
+platform_profile::platform_profile ()
+    : platform_profile("/sys")
+{}
+
+platform_profile::platform_profile (std::string const & sysfs_root)
+{
+    _d.reset(new details::platform_profile(sysfs_root));
+}
+
+platform_profile::~platform_profile ()
+{}
+
+bool platform_profile::is_supported () const
+{
+    return _d->is_supported();
+}
+
+std::vector<std::string> platform_profile::choices () const
+{
+    return _d->choices();
+}
+
+bool platform_profile::has_choice (std::string const & profile) const
+{
+    return _d->has_choice(profile);
+}
+
+std::string platform_profile::current () const
+{
+    return _d->current();
+}
+
+bool platform_profile::refresh ()
+{
+    return _d->refresh();
+}
+
+int platform_profile::native_handle () const
+{
+    return _d->native_handle();
+}
+
+bool platform_profile::set (std::string const & profile)
+{
+    return _d->set(profile);
+}
+
+scoped_platform_profile::scoped_platform_profile (platform_profile & pp
+        , std::string const & profile)
+    : _pp(pp)
+{
+    _pp.refresh();
+    _saved = _pp.current();
+
+    if (_saved == profile)
+        return;
+
+    _active = _pp.set(profile);
+}
+
+scoped_platform_profile::~scoped_platform_profile ()
+{
+    if (_active)
+        _pp.set(_saved);
+}
+
+} // namespace pfs
@@ -0,0 +1,378 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026 Vladislav Trifochkin
+//
+// This file is part of [pfs-acpi](https://github.com/semenovf/pfs-acpi) library.
+//
+// Changelog:
+//      2026.10.17 Initial version
+//      2026.10.17 Added low-power mode
+//      2026.10.17 Start and stop times are read atomically by `stats()`
+////////////////////////////////////////////////////////////////////////////////
+#include "pfs/acpi/poller.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <future>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <pthread.h>
+#include <sched.h>
+#include <time.h>
+#include <sys/prctl.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+namespace pfs {
+
+namespace details {
+
+inline long long to_ns (struct timespec const & ts)
+{
+    return static_cast<long long>(ts.tv_sec) * 1000000000LL + ts.tv_nsec;
+}
+
+inline long long thread_cpu_time_ns ()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, & ts);
+    return to_ns(ts);
+}
+
+// Applies options to the calling thread
+static bool apply_thread_options (poller_options const & options)
+{
+    if (!options.cpus.empty()) {
+        cpu_set_t set;
+        CPU_ZERO(& set);
+
+        for (auto cpu: options.cpus)
+            CPU_SET(cpu, & set);
+
+        if (pthread_setaffinity_np(pthread_self(), sizeof(set), & set) != 0)
+            return false;
+    }
+
+    if (options.sched == poller_options::sched_idle) {
+        struct sched_param param;
+        param.sched_priority = 0;
+
+        if (sched_setscheduler(0, SCHED_IDLE, & param) != 0)
+            return false;
+    } else if (options.nice != 0) {
+        // Nice value is per thread on Linux
+        auto tid = static_cast<id_t>(::syscall(SYS_gettid));
+
+        if (setpriority(PRIO_PROCESS, tid, options.nice) != 0)
+            return false;
+    }
+
+    if (options.timer_slack_ns >= 0) {
+        // Zero resets slack to default value, so minimal slack is 1 ns
+        auto slack = options.timer_slack_ns > 0 ? options.timer_slack_ns : 1;
+
+        if (prctl(PR_SET_TIMERSLACK, static_cast<unsigned long>(slack), 0, 0, 0) != 0)
+            return false;
+    }
+
+    return true;
+}
+
+class acpi_poller
+{
+    using clock_type = std::chrono::steady_clock;
+
+    struct schedule_item
+    {
+        int devices;
+        clock_type::duration interval;
+        clock_type::time_point deadline;
+    };
+
+public:
+    ~acpi_poller ()
+    {
+        stop();
+    }
+
+    bool start (pfs::acpi & a, poller_options const & options
+        , pfs::acpi_poller::callback_type callback)
+    {
+        if (_thread.joinable())
+            return false;
+
+        _options = options;
+        _callback = std::move(callback);
+        _stop = false;
+        _wakeups = 0;
+        _cpu_time_ns = 0;
+        _last_cpu = -1;
+        _cpus_mask = 0;
+        _class_updates = 0;
+        _on_battery = false;
+        _start_time = clock_type::now();
+        _stop_time = _start_time.load();
+
+        std::promise<bool> ready;
+        auto ready_result = ready.get_future();
+
+        _thread = std::thread([this, & a, & ready] {
+            if (!apply_thread_options(_options)) {
+                ready.set_value(false);
+                return;
+            }
+
+            ready.set_value(true);
+            run(a);
+        });
+
+        if (!ready_result.get()) {
+            _thread.join();
+            return false;
+        }
+
+        return true;
+    }
+
+    void stop ()
+    {
+        if (!_thread.joinable())
+            return;
+
+        {
+            std::lock_guard<std::mutex> locker(_mutex);
+            _stop = true;
+        }
+
+        _cond.notify_one();
+        _thread.join();
+        _stop_time = clock_type::now();
+    }
+
+    bool is_running () const
+    {
+        return _thread.joinable();
+    }
+
+    poller_stats stats () const
+    {
+        poller_stats result;
+        result.wakeups = _wakeups.load();
+        result.cpu_time_ns = _cpu_time_ns.load();
+        result.last_cpu = _last_cpu.load();
+        result.cpus_mask = _cpus_mask.load();
+        result.class_updates = _class_updates.load();
+        result.on_battery = _on_battery.load();
+        result.wakeups_per_second = 0;
+
+        auto finish = is_running() ? clock_type::now() : _stop_time.load();
+        std::chrono::duration<double> elapsed = finish - _start_time.load();
+
+        if (elapsed.count() > 0)
+            result.wakeups_per_second = result.wakeups / elapsed.count();
+
+        result.wakeups_per_minute = result.wakeups_per_second * 60;
+
+        return result;
+    }
+
+private:
+    void account_wakeup ()
+    {
+        ++_wakeups;
+
+        auto cpu = sched_getcpu();
+        _last_cpu = cpu;
+
+        if (cpu >= 0 && cpu < 64)
+            _cpus_mask |= std::uint64_t{1} << cpu;
+    }
+
+    bool track_power_source () const
+    {
+        return _options.low_power && _options.battery_interval_factor > 1;
+    }
+
+    void update_power_source (pfs::acpi const & a)
+    {
+        auto count = a.ac_adapters_available();
+        bool online = false;
+
+        for (size_t i = 0; i < count && !online; i++)
+            online = a.ac_adapter_at(static_cast<int>(i)).state == ac_state_enum::online;
+
+        // No AC adapters (e.g. desktop) means mains powered
+        _on_battery = count > 0 && !online;
+    }
+
+    // Rounds time point up to the grid in low-power mode
+    clock_type::time_point align (clock_type::time_point t) const
+    {
+        if (!_options.low_power || _options.grid_ms <= 0)
+            return t;
+
+        clock_type::duration grid = std::chrono::milliseconds(_options.grid_ms);
+        auto remainder = t.time_since_epoch() % grid;
+
+        return remainder.count() == 0 ? t : t + (grid - remainder);
+    }
+
+    clock_type::duration scaled (clock_type::duration interval) const
+    {
+        return _on_battery ? interval * _options.battery_interval_factor : interval;
+    }
+
+    clock_type::time_point next_deadline (schedule_item const & item, clock_type::time_point now) const
+    {
+        auto interval = scaled(item.interval);
+        auto next = item.deadline + interval;
+
+        // Skip missed deadlines instead of polling back-to-back
+        if (next <= now)
+            next += ((now - next) / interval + 1) * interval;
+
+        return align(next);
+    }
+
+    void run (pfs::acpi & a)
+    {
+        std::vector<schedule_item> schedule;
+
+        if (_options.class_intervals.empty()) {
+            schedule.push_back(schedule_item{_options.devices
+                , std::chrono::milliseconds(std::max(_options.interval_ms, 1))
+                , clock_type::time_point{}});
+        } else {
+            for (auto const & x: _options.class_intervals) {
+                schedule.push_back(schedule_item{x.devices
+                    , std::chrono::milliseconds(std::max(x.interval_ms, 1))
+                    , clock_type::time_point{}});
+            }
+        }
+
+        // AC adapters are re-read by each wakeup to stretch intervals in time,
+        // it costs single read and no extra wakeups
+        int extra_devices = track_power_source() ? pfs::acpi::dev_ac_adapter : 0;
+        int all_devices = extra_devices;
+
+        for (auto const & item: schedule)
+            all_devices |= item.devices;
+
+        account_wakeup();
+        a.acquire(all_devices);
+        _class_updates += schedule.size();
+
+        if (track_power_source())
+            update_power_source(a);
+
+        if (_callback)
+            _callback(a);
+
+        _cpu_time_ns = thread_cpu_time_ns();
+
+        auto last_wakeup = clock_type::now();
+
+        for (auto & item: schedule)
+            item.deadline = align(last_wakeup + scaled(item.interval));
+
+        clock_type::duration min_gap = clock_type::duration::zero();
+
+        if (_options.wakeups_per_minute > 0)
+            min_gap = std::chrono::duration_cast<clock_type::duration>(std::chrono::minutes(1))
+                / _options.wakeups_per_minute;
+
+        std::unique_lock<std::mutex> locker(_mutex);
+
+        while (!_stop) {
+            auto next = schedule.front().deadline;
+
+            for (auto const & item: schedule)
+                next = std::min(next, item.deadline);
+
+            // Postponed wakeup updates all classes due by that time
+            next = align(std::max(next, last_wakeup + min_gap));
+
+            if (_cond.wait_until(locker, next, [this] { return _stop; }))
+                break;
+
+            locker.unlock();
+            account_wakeup();
+
+            auto now = clock_type::now();
+            int devices = extra_devices;
+            last_wakeup = now;
+
+            for (auto & item: schedule) {
+                if (item.deadline <= now) {
+                    devices |= item.devices;
+                    ++_class_updates;
+                    item.deadline = next_deadline(item, now);
+                }
+            }
+
+            if (_options.refresh)
+                a.refresh(devices);
+            else
+                a.acquire(devices);
+
+            if (track_power_source())
+                update_power_source(a);
+
+            if (_callback)
+                _callback(a);
+
+            _cpu_time_ns = thread_cpu_time_ns();
+            locker.lock();
+        }
+    }
+
+private:
+    poller_options _options;
+    pfs::acpi_poller::callback_type _callback;
+    std::thread _thread;
+    std::mutex _mutex;
+    std::condition_variable _cond;
+    bool _stop {false};
+    std::atomic<clock_type::time_point> _start_time {clock_type::time_point{}};
+    std::atomic<clock_type::time_point> _stop_time {clock_type::time_point{}};
+    std::atomic<std::uint64_t> _wakeups {0};
+    std::atomic<long long> _cpu_time_ns {0};
+    std::atomic<int> _last_cpu {-1};
+    std::atomic<std::uint64_t> _cpus_mask {0};
+    std::atomic<std::uint64_t> _class_updates {0};
+    std::atomic<bool> _on_battery {false};
+};
+
+} // namespace details
+
+acpi_poller::acpi_poller ()
+{
+    _d.reset(new details::acpi_poller);
+}
+
+acpi_poller::~acpi_poller ()
+{}
+
+bool acpi_poller::start (acpi & a, poller_options const & options, callback_type callback)
+{
+    return _d->start(a, options, std::move(callback));
+}
+
+void acpi_poller::stop ()
+{
+    _d->stop();
+}
+
+bool acpi_poller::is_running () const
+{
+    return _d->is_running();
+}
+
+poller_stats acpi_poller::stats () const
+{
+    return _d->stats();
+}
+
+} // namespace pfs
@@ -0,0 +1,358 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026 Vladislav Trifochkin
+//
+// This file is part of [pfs-acpi](https://github.com/semenovf/pfs-acpi) library.
+//
+// Changelog:
+//      2026.10.17 Initial version
+//      2026.10.17 Scoped power limit does not refresh energy counters
+////////////////////////////////////////////////////////////////////////////////
+#include "pfs/acpi/powercap.hpp"
+#include "sysfs.hpp"
+#include <algorithm>
+#include <string>
+#include <vector>
+#include <time.h>
+
+//
+// [Power Capping Framework](https://docs.kernel.org/power/powercap/powercap.html)
+//
+
+namespace pfs {
+
+static char const * POWERCAP_PATH = "/class/powercap";
+
+namespace details {
+
+struct power_constraint_attributes
+{
+    sysfs_attribute power_limit_attr;
+    sysfs_attribute time_window_attr;
+};
+
+struct power_domain_extended : power_domain
+{
+    sysfs_attribute energy_attr;
+    std::vector<power_constraint_attributes> constraint_attrs; // parallel to `constraints`
+    long long last_timestamp_ns {0};
+};
+
+static long long monotonic_ns ()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, & ts);
+    return static_cast<long long>(ts.tv_sec) * 1000000000LL + ts.tv_nsec;
+}
+
+static long long read_value (sysfs_attribute const & attr)
+{
+    long long value = -1;
+    return attr.read_int(value) ? value : -1;
+}
+
+static void open_writable (sysfs_attribute & attr, std::string const & path)
+{
+    if (!attr.open(path, O_RDWR))
+        attr.open(path, O_RDONLY);
+}
+
+class powercap
+{
+public:
+    powercap (std::string const & sysfs_root)
+        : _root_dir(sysfs_root + POWERCAP_PATH)
+    {}
+
+    void discover ();
+    void refresh ();
+
+    size_t domains_available () const
+    {
+        return _domains.size();
+    }
+
+    power_domain domain_at (int index) const
+    {
+        if (index >= 0 && index < _domains.size()) {
+            return _domains[index];
+        }
+        return power_domain{};
+    }
+
+    int find_domain (std::string const & name) const
+    {
+        for (int i = 0; i < _domains.size(); i++) {
+            if (_domains[i].name == name || _domains[i].domain == name)
+                return i;
+        }
+
+        return -1;
+    }
+
+    int find_constraint (int domain_index, std::string const & name) const
+    {
+        if (domain_index < 0 || domain_index >= _domains.size())
+            return -1;
+
+        auto const & constraints = _domains[domain_index].constraints;
+
+        for (int i = 0; i < constraints.size(); i++) {
+            if (constraints[i].name == name)
+                return i;
+        }
+
+        return -1;
+    }
+
+    bool refresh_constraint (int domain_index, int constraint_index)
+    {
+        if (!valid_constraint(domain_index, constraint_index))
+            return false;
+
+        read_constraint(_domains[domain_index], constraint_index);
+        return true;
+    }
+
+    bool set_power_limit (int domain_index, int constraint_index, long long value)
+    {
+        if (!valid_constraint(domain_index, constraint_index))
+            return false;
+
+        auto & d = _domains[domain_index];
+
+        if (!write_value(d.constraint_attrs[constraint_index].power_limit_attr, value))
+            return false;
+
+        d.constraints[constraint_index].power_limit_uw = value;
+        return true;
+    }
+
+    bool set_time_window (int domain_index, int constraint_index, long long value)
+    {
+        if (!valid_constraint(domain_index, constraint_index))
+            return false;
+
+        auto & d = _domains[domain_index];
+
+        if (!write_value(d.constraint_attrs[constraint_index].time_window_attr, value))
+            return false;
+
+        d.constraints[constraint_index].time_window_us = value;
+        return true;
+    }
+
+private:
+    bool valid_constraint (int domain_index, int constraint_index) const
+    {
+        return domain_index >= 0 && domain_index < _domains.size()
+            && constraint_index >= 0
+            && constraint_index < _domains[domain_index].constraints.size();
+    }
+
+    static bool write_value (sysfs_attribute const & attr, long long value)
+    {
+        auto s = std::to_string(value);
+        return attr.write(s);
+    }
+
+    void read_energy (power_domain_extended & d, long long now);
+
+    static void read_constraint (power_domain_extended & d, size_t index)
+    {
+        auto & c = d.constraints[index];
+        auto const & attrs = d.constraint_attrs[index];
+        c.power_limit_uw = read_value(attrs.power_limit_attr);
+        c.time_window_us = read_value(attrs.time_window_attr);
+    }
+
+private:
+    std::string _root_dir;
+    std::vector<power_domain_extended> _domains;
+};
+
+void powercap::read_energy (power_domain_extended & d, long long now)
+{
+    auto prev_energy = d.energy_uj;
+    auto prev_timestamp = d.last_timestamp_ns;
+
+    d.energy_uj = read_value(d.energy_attr);
+    d.last_timestamp_ns = now;
+    d.power_uw = -1;
+
+    if (prev_energy < 0 || d.energy_uj < 0 || prev_timestamp <= 0 || now <= prev_timestamp)
+        return;
+
+    auto delta = d.energy_uj - prev_energy;
+
+    // Energy counter wrapped around
+    if (delta < 0 && d.max_energy_range_uj > 0)
+        delta += d.max_energy_range_uj + 1;
+
+    if (delta >= 0)
+        d.power_uw = static_cast<long long>(static_cast<double>(delta) * 1e9 / (now - prev_timestamp));
+}
+
+void powercap::discover ()
+{
+    _domains.clear();
+
+    acquire_devices(_root_dir.c_str(), 0, [this] (char const * direntry, int) {
+        // Skip control types (e.g. `intel-rapl`), zones are named `<type>:<id>[:<id>]`
+        if (!strchr(direntry, ':'))
+            return;
+
+        std::string root_dir {_root_dir};
+        root_dir += '/';
+        root_dir += direntry;
+
+        _domains.emplace_back();
+        auto & d = _domains.back();
+        d.name = direntry;
+        d.domain = read_all(root_dir + "/name", true);
+
+        auto enabled = read_all(root_dir + "/enabled", true);
+        d.enabled = !enabled.empty() && unit_value(enabled) != 0;
+
+        auto max_energy_range = read_all(root_dir + "/max_energy_range_uj", true);
+        d.max_energy_range_uj = max_energy_range.empty() ? -1 : atoll(max_energy_range.c_str());
+
+        d.energy_uj = -1;
+        d.power_uw = -1;
+        d.energy_attr.open(root_dir + "/energy_uj");
+
+        for (int i = 0; ; i++) {
+            auto prefix = root_dir + "/constraint_" + std::to_string(i);
+            auto name = read_all(prefix + "_name", true);
+
+            if (name.empty())
+                break;
+
+            d.constraints.emplace_back();
+            auto & c = d.constraints.back();
+            c.name = name;
+            c.power_limit_uw = -1;
+            c.time_window_us = -1;
+
+            auto max_power = read_all(prefix + "_max_power_uw", true);
+            c.max_power_uw = max_power.empty() ? -1 : atoll(max_power.c_str());
+
+            d.constraint_attrs.emplace_back();
+            auto & attrs = d.constraint_attrs.back();
+            open_writable(attrs.power_limit_attr, prefix + "_power_limit_uw");
+            open_writable(attrs.time_window_attr, prefix + "_time_window_us");
+        }
+    });
+
+    std::sort(_domains.begin(), _domains.end()
+        , [] (power_domain_extended const & a, power_domain_extended const & b) {
+            return a.name < b.name;
+        });
+
+    refresh();
+}
+
+void powercap::refresh ()
+{
+    auto now = monotonic_ns();
+
+    for (auto & d: _domains) {
+        read_energy(d, now);
+
+        for (size_t i = 0; i < d.constraints.size(); i++)
+            read_constraint(d, i);
+    }
+}
+
+} // namespace details
+
+powercap::powercap ()
+    : powercap("/sys")
+{}
+
+powercap::powercap (std::string const & sysfs_root)
+{
+    _d.reset(new details::powercap(sysfs_root));
+}
+
+powercap::~powercap ()
+{}
+
+void powercap::discover ()
+{
+    _d->discover();
+}
+
+void powercap::refresh ()
+{
+    _d->refresh();
+}
+
+size_t powercap::domains_available () const
+{
+    return _d->domains_available();
+}
+
+power_domain powercap::domain_at (int index) const
+{
+    return _d->domain_at(index);
+}
+
+int powercap::find_domain (std::string const & name) const
+{
+    return _d->find_domain(name);
+}
+
+int powercap::find_constraint (int domain_index, std::string const & name) const
+{
+    return _d->find_constraint(domain_index, name);
+}
+
+bool powercap::refresh_constraint (int domain_index, int constraint_index)
+{
+    return _d->refresh_constraint(domain_index, constraint_index);
+}
+
+bool powercap::set_power_limit (int domain_index, int constraint_index, long long power_limit_uw)
+{
+    return _d->set_power_limit(domain_index, constraint_index, power_limit_uw);
+}
+
+bool powercap::set_time_window (int domain_index, int constraint_index, long long time_window_us)
+{
+    return _d->set_time_window(domain_index, constraint_index, time_window_us);
+}
+
+scoped_power_limit::scoped_power_limit (powercap & pc, int domain_index
+        , int constraint_index, long long power_limit_uw, long long time_window_us)
+    : _pc(pc)
+    , _domain_index(domain_index)
+    , _constraint_index(constraint_index)
+{
+    // Energy counters are not touched, so caller's power deltas stay valid
+    if (!_pc.refresh_constraint(domain_index, constraint_index))
+        return;
+
+    auto d = _pc.domain_at(domain_index);
+
+    auto const & c = d.constraints[constraint_index];
+    _saved_power_limit_uw = c.power_limit_uw;
+    _saved_time_window_us = c.time_window_us;
+
+    // Time window is set first: kernel may validate power limit against it
+    if (time_window_us >= 0 && _saved_time_window_us >= 0 && time_window_us != _saved_time_window_us)
+        _time_window_changed = _pc.set_time_window(domain_index, constraint_index, time_window_us);
+
+    if (power_limit_uw >= 0 && _saved_power_limit_uw >= 0 && power_limit_uw != _saved_power_limit_uw)
+        _power_limit_changed = _pc.set_power_limit(domain_index, constraint_index, power_limit_uw);
+}
+
+scoped_power_limit::~scoped_power_limit ()
+{
+    if (_power_limit_changed)
+        _pc.set_power_limit(_domain_index, _constraint_index, _saved_power_limit_uw);
+
+    if (_time_window_changed)
+        _pc.set_time_window(_domain_index, _constraint_index, _saved_time_window_us);
+}
+
+} // namespace pfs
@@ -0,0 +1,69 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026 Vladislav Trifochkin
+//
+// This file is part of [pfs-acpi](https://github.com/semenovf/pfs-acpi) library.
+//
+// Changelog:
+//      2026.10.17 Initial version
+////////////////////////////////////////////////////////////////////////////////
+#pragma once
+#include "pfs/acpi/read_latency.hpp"
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <time.h>
+
+namespace pfs {
+namespace details {
+
+// Histogram of single attribute updated by concurrent readers
+struct latency_slot
+{
+    std::string path;
+    int device;
+    std::atomic<std::uint64_t> counts[latency_histogram::BUCKETS];
+    std::atomic<std::uint64_t> sum_ns;
+    std::atomic<std::uint64_t> max_ns;
+
+    void record (std::uint64_t ns)
+    {
+        counts[latency_histogram::bucket_of(ns)].fetch_add(1, std::memory_order_relaxed);
+        sum_ns.fetch_add(ns, std::memory_order_relaxed);
+
+        auto max = max_ns.load(std::memory_order_relaxed);
+
+        while (ns > max && !max_ns.compare_exchange_weak(max, ns, std::memory_order_relaxed))
+            ;
+    }
+};
+
+class latency_registry
+{
+public:
+    static bool enabled ()
+    {
+        return _enabled.load(std::memory_order_relaxed);
+    }
+
+    static void set_enabled (bool on)
+    {
+        _enabled.store(on, std::memory_order_relaxed);
+    }
+
+    // Returns slot of attribute creating it on first call for `path`.
+    // Slots are never destroyed.
+    static latency_slot * slot (std::string const & path, int device);
+
+private:
+    static std::atomic<bool> _enabled;
+};
+
+inline std::uint64_t latency_clock_ns ()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, & ts);
+    return static_cast<std::uint64_t>(ts.tv_sec) * 1000000000ULL
+        + static_cast<std::uint64_t>(ts.tv_nsec);
+}
+
+}} // namespace pfs::details
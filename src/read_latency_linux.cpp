@@ -0,0 +1,214 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026 Vladislav Trifochkin
+//
+// This file is part of [pfs-acpi](https://github.com/semenovf/pfs-acpi) library.
+//
+// Changelog:
+//      2026.10.17 Initial version
+////////////////////////////////////////////////////////////////////////////////
+#include "read_latency.hpp"
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace pfs {
+
+constexpr int latency_histogram::SUB_BUCKET_BITS;
+constexpr int latency_histogram::SUB_BUCKETS;
+constexpr int latency_histogram::MAX_EXPONENT;
+constexpr int latency_histogram::BUCKETS;
+
+namespace details {
+
+struct latency_data
+{
+    std::mutex mutex;
+    std::vector<std::unique_ptr<latency_slot>> slots;
+    std::unordered_map<std::string, latency_slot *> index;
+};
+
+std::atomic<bool> latency_registry::_enabled {false};
+
+static latency_data & data ()
+{
+    static latency_data d;
+    return d;
+}
+
+static void clear_slot (latency_slot & slot)
+{
+    for (auto & c: slot.counts)
+        c.store(0, std::memory_order_relaxed);
+
+    slot.sum_ns.store(0, std::memory_order_relaxed);
+    slot.max_ns.store(0, std::memory_order_relaxed);
+}
+
+static void copy_slot (latency_slot const & slot, latency_histogram & h)
+{
+    h.count = 0;
+
+    for (int i = 0; i < latency_histogram::BUCKETS; i++) {
+        h.counts[i] = slot.counts[i].load(std::memory_order_relaxed);
+        h.count += h.counts[i];
+    }
+
+    h.sum_ns = slot.sum_ns.load(std::memory_order_relaxed);
+    h.max_ns = slot.max_ns.load(std::memory_order_relaxed);
+}
+
+latency_slot * latency_registry::slot (std::string const & path, int device)
+{
+    auto & d = data();
+    std::lock_guard<std::mutex> locker(d.mutex);
+
+    auto pos = d.index.find(path);
+
+    if (pos != d.index.end())
+        return pos->second;
+
+    std::unique_ptr<latency_slot> slot {new latency_slot};
+    slot->path = path;
+    slot->device = device;
+    clear_slot(*slot);
+
+    auto result = slot.get();
+    d.slots.push_back(std::move(slot));
+    d.index.emplace(path, result);
+    return result;
+}
+
+} // namespace details
+
+int latency_histogram::bucket_of (std::uint64_t ns)
+{
+    if (ns < static_cast<std::uint64_t>(SUB_BUCKETS))
+        return static_cast<int>(ns);
+
+    if (ns >= (1ULL << MAX_EXPONENT))
+        return BUCKETS - 1;
+
+    int exponent = 63 - __builtin_clzll(ns);
+    auto sub_bucket = static_cast<int>(ns >> (exponent - SUB_BUCKET_BITS)) & (SUB_BUCKETS - 1);
+    return (exponent - SUB_BUCKET_BITS + 1) * SUB_BUCKETS + sub_bucket;
+}
+
+std::uint64_t latency_histogram::bucket_lower (int bucket)
+{
+    if (bucket < SUB_BUCKETS)
+        return static_cast<std::uint64_t>(bucket);
+
+    int exponent = bucket / SUB_BUCKETS + SUB_BUCKET_BITS - 1;
+    auto sub_bucket = static_cast<std::uint64_t>(bucket % SUB_BUCKETS);
+    return (SUB_BUCKETS + sub_bucket) << (exponent - SUB_BUCKET_BITS);
+}
+
+std::uint64_t latency_histogram::bucket_upper (int bucket)
+{
+    if (bucket < SUB_BUCKETS)
+        return static_cast<std::uint64_t>(bucket);
+
+    int exponent = bucket / SUB_BUCKETS + SUB_BUCKET_BITS - 1;
+    return bucket_lower(bucket) + (1ULL << (exponent - SUB_BUCKET_BITS)) - 1;
+}
+
+std::uint64_t latency_histogram::percentile (double percent) const
+{
+    if (count == 0)
+        return 0;
+
+    auto target = static_cast<std::uint64_t>(std::ceil(percent / 100.0 * count));
+
+    if (target == 0)
+        target = 1;
+
+    std::uint64_t seen = 0;
+
+    for (int i = 0; i < BUCKETS; i++) {
+        seen += counts[i];
+
+        if (seen >= target)
+            return bucket_upper(i) < max_ns ? bucket_upper(i) : max_ns;
+    }
+
+    return max_ns;
+}
+
+double latency_histogram::mean_ns () const
+{
+    return count == 0 ? 0 : static_cast<double>(sum_ns) / count;
+}
+
+void latency_histogram::merge (latency_histogram const & other)
+{
+    for (int i = 0; i < BUCKETS; i++)
+        counts[i] += other.counts[i];
+
+    count += other.count;
+    sum_ns += other.sum_ns;
+
+    if (other.max_ns > max_ns)
+        max_ns = other.max_ns;
+}
+
+void read_latency::enable (bool on)
+{
+    details::latency_registry::set_enabled(on);
+}
+
+bool read_latency::is_enabled ()
+{
+    return details::latency_registry::enabled();
+}
+
+std::vector<attribute_latency> read_latency::snapshot ()
+{
+    auto & d = details::data();
+    std::lock_guard<std::mutex> locker(d.mutex);
+    std::vector<attribute_latency> result(d.slots.size());
+
+    for (std::size_t i = 0; i < d.slots.size(); i++) {
+        result[i].path = d.slots[i]->path;
+        result[i].device = d.slots[i]->device;
+        details::copy_slot(*d.slots[i], result[i].histogram);
+    }
+
+    return result;
+}
+
+latency_histogram read_latency::snapshot (int devices)
+{
+    latency_histogram result;
+    latency_histogram h;
+
+    std::fill(result.counts, result.counts + latency_histogram::BUCKETS, 0);
+    result.count = 0;
+    result.sum_ns = 0;
+    result.max_ns = 0;
+
+    auto & d = details::data();
+    std::lock_guard<std::mutex> locker(d.mutex);
+
+    for (auto const & slot: d.slots) {
+        if (slot->device & devices) {
+            details::copy_slot(*slot, h);
+            result.merge(h);
+        }
+    }
+
+    return result;
+}
+
+void read_latency::reset ()
+{
+    auto & d = details::data();
+    std::lock_guard<std::mutex> locker(d.mutex);
+
+    for (auto & slot: d.slots)
+        details::clear_slot(*slot);
+}
+
+} // namespace pfs
@@ -0,0 +1,124 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026 Vladislav Trifochkin
+//
+// This file is part of [pfs-acpi](https://github.com/semenovf/pfs-acpi) library.
+//
+// Changelog:
+//      2026.10.17 Initial version
+////////////////////////////////////////////////////////////////////////////////
+#include "pfs/acpi/realtime_reader.hpp"
+#include "sysfs.hpp"
+#include <string>
+#include <vector>
+#include <alloca.h>
+#include <malloc.h>
+#include <sys/mman.h>
+
+namespace pfs {
+
+constexpr long long realtime_reader::INVALID_VALUE;
+
+namespace details {
+
+class realtime_reader
+{
+public:
+    int add_attribute (std::string const & path)
+    {
+        sysfs_attribute attr;
+
+        if (!attr.open(path))
+            return -1;
+
+        _attrs.push_back(std::move(attr));
+        return static_cast<int>(_attrs.size() - 1);
+    }
+
+    size_t attributes_count () const
+    {
+        return _attrs.size();
+    }
+
+    long long read (size_t attribute) const
+    {
+        long long value = 0;
+        return _attrs[attribute].read_int(value) ? value : pfs::realtime_reader::INVALID_VALUE;
+    }
+
+private:
+    std::vector<sysfs_attribute> _attrs;
+};
+
+// Touches stack pages, so the first cycles don't fault on them
+__attribute__((noinline))
+static void prefault_stack (size_t size)
+{
+    size_t const PAGE_STRIDE = 4096;
+    auto p = static_cast<volatile char *>(alloca(size));
+
+    for (size_t i = 0; i < size; i += PAGE_STRIDE)
+        p[i] = 0;
+}
+
+} // namespace details
+
+realtime_reader::realtime_reader ()
+{
+    _d.reset(new details::realtime_reader);
+}
+
+realtime_reader::~realtime_reader ()
+{}
+
+int realtime_reader::add_attribute (std::string const & path)
+{
+    return _d->add_attribute(path);
+}
+
+size_t realtime_reader::attributes_count () const
+{
+    return _d->attributes_count();
+}
+
+bool realtime_reader::prepare (size_t stack_size)
+{
+    bool success = true;
+
+    for (size_t i = 0; i < _d->attributes_count(); i++)
+        success = _d->read(i) != INVALID_VALUE && success;
+
+    details::prefault_stack(stack_size);
+    return success;
+}
+
+bool realtime_reader::lock_memory ()
+{
+    mallopt(M_TRIM_THRESHOLD, -1);
+    mallopt(M_MMAP_MAX, 0);
+
+    return ::mlockall(MCL_CURRENT | MCL_FUTURE) == 0;
+}
+
+size_t realtime_reader::read (long long * values) const
+{
+    size_t count = 0;
+
+    for (size_t i = 0; i < _d->attributes_count(); i++) {
+        values[i] = _d->read(i);
+
+        if (values[i] != INVALID_VALUE)
+            ++count;
+    }
+
+    return count;
+}
+
+long long realtime_reader::read (int attribute) const
+{
+    if (attribute < 0 || static_cast<size_t>(attribute) >= _d->attributes_count())
+        return INVALID_VALUE;
+
+    return _d->read(static_cast<size_t>(attribute));
+}
+
+} // namespace pfs
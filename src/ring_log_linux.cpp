@@ -0,0 +1,424 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026 Vladislav Trifochkin
+//
+// This file is part of [pfs-acpi](https://github.com/semenovf/pfs-acpi) library.
+//
+// Changelog:
+//      2026.10.17 Initial version
+//      2026.10.17 Sensor columns are shared with `sample_recorder`
+////////////////////////////////////////////////////////////////////////////////
+#include "pfs/acpi/ring_log.hpp"
+#include "sensor_row.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <fcntl.h>
+#include <time.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace pfs {
+
+constexpr std::size_t ring_log_record::MAX_SENSORS;
+
+namespace details {
+
+static char const LOG_MAGIC[8] = {'P', 'F', 'S', 'A', 'C', 'P', 'I', 'R'};
+static std::uint32_t const LOG_VERSION = 1;
+static std::size_t const NAME_SIZE = 32;
+static std::size_t const HEADER_SIZE = 4096; // records start at page boundary
+
+// Values are stored in native byte order
+struct log_header
+{
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t header_size;
+    std::uint32_t record_size;
+    std::uint32_t capacity;
+    std::uint32_t sensors;
+    std::uint32_t reserved;
+    char names[ring_log_record::MAX_SENSORS][NAME_SIZE];
+    std::uint32_t checksum; // CRC-32 of the fields above
+    std::uint32_t reserved2;
+    std::uint64_t next_seq; // updated atomically by writers
+};
+
+static_assert(sizeof(log_header) <= HEADER_SIZE, "log header too large");
+
+static std::uint32_t crc32 (void const * data, std::size_t size)
+{
+    static std::uint32_t table[256];
+    static bool initialized = [] {
+        for (std::uint32_t i = 0; i < 256; i++) {
+            auto c = i;
+
+            for (int k = 0; k < 8; k++)
+                c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+
+            table[i] = c;
+        }
+
+        return true;
+    }();
+
+    (void)initialized;
+
+    auto p = static_cast<unsigned char const *>(data);
+    std::uint32_t crc = 0xFFFFFFFFu;
+
+    for (std::size_t i = 0; i < size; i++)
+        crc = table[(crc ^ p[i]) & 0xFF] ^ (crc >> 8);
+
+    return crc ^ 0xFFFFFFFFu;
+}
+
+inline std::uint32_t header_checksum (log_header const & h)
+{
+    return crc32(& h, offsetof(log_header, checksum));
+}
+
+inline std::uint32_t record_checksum (ring_log_record rec)
+{
+    rec.checksum = 0;
+    return crc32(& rec, sizeof(rec));
+}
+
+inline std::size_t file_size (std::size_t capacity)
+{
+    return HEADER_SIZE + capacity * sizeof(ring_log_record);
+}
+
+class ring_log
+{
+public:
+    ~ring_log ()
+    {
+        close();
+    }
+
+    bool open (std::string const & path, size_t capacity
+        , std::vector<std::string> const & sensor_names)
+    {
+        close();
+
+        if (capacity == 0)
+            return false;
+
+        log_header expected;
+        std::memset(& expected, 0, sizeof(expected));
+        std::memcpy(expected.magic, LOG_MAGIC, sizeof(LOG_MAGIC));
+        expected.version = LOG_VERSION;
+        expected.header_size = HEADER_SIZE;
+        expected.record_size = sizeof(ring_log_record);
+        expected.capacity = static_cast<std::uint32_t>(capacity);
+        expected.sensors = static_cast<std::uint32_t>(std::min(sensor_names.size()
+            , ring_log_record::MAX_SENSORS));
+
+        for (std::uint32_t i = 0; i < expected.sensors; i++)
+            sensor_names[i].copy(expected.names[i], NAME_SIZE - 1);
+
+        expected.checksum = header_checksum(expected);
+
+        int fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+
+        if (fd < 0)
+            return false;
+
+        struct stat st;
+        auto size = file_size(capacity);
+        bool reuse = fstat(fd, & st) == 0 && static_cast<std::size_t>(st.st_size) == size;
+
+        if (!reuse) {
+            if (ftruncate(fd, 0) != 0 || ftruncate(fd, static_cast<off_t>(size)) != 0) {
+                ::close(fd);
+                return false;
+            }
+        }
+
+        auto p = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        ::close(fd);
+
+        if (p == MAP_FAILED)
+            return false;
+
+        _base = p;
+        _size = size;
+        _writable = true;
+
+        // Continue existing log of the same layout
+        if (!reuse || std::memcmp(header(), & expected, offsetof(log_header, reserved2)) != 0) {
+            std::memset(_base, 0, _size);
+            std::memcpy(header(), & expected, sizeof(expected));
+        }
+
+        count_classes();
+        return true;
+    }
+
+    bool open (std::string const & path)
+    {
+        close();
+
+        int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+
+        if (fd < 0)
+            return false;
+
+        struct stat st;
+
+        if (fstat(fd, & st) != 0 || static_cast<std::size_t>(st.st_size) < HEADER_SIZE) {
+            ::close(fd);
+            return false;
+        }
+
+        auto size = static_cast<std::size_t>(st.st_size);
+        auto p = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+        ::close(fd);
+
+        if (p == MAP_FAILED)
+            return false;
+
+        _base = p;
+        _size = size;
+        _writable = false;
+
+        auto h = header();
+
+        bool valid = std::memcmp(h->magic, LOG_MAGIC, sizeof(LOG_MAGIC)) == 0
+            && h->version == LOG_VERSION
+            && h->header_size == HEADER_SIZE
+            && h->record_size == sizeof(ring_log_record)
+            && h->capacity > 0
+            && h->sensors <= ring_log_record::MAX_SENSORS
+            && file_size(h->capacity) == size
+            && h->checksum == header_checksum(*h);
+
+        if (!valid) {
+            close();
+            return false;
+        }
+
+        count_classes();
+        return true;
+    }
+
+    void close ()
+    {
+        if (_base != nullptr) {
+            munmap(_base, _size);
+            _base = nullptr;
+            _size = 0;
+            _writable = false;
+            _thermal_zones = 0;
+            _batteries = 0;
+            _fans = 0;
+        }
+    }
+
+    bool is_open () const
+    {
+        return _base != nullptr;
+    }
+
+    size_t capacity () const
+    {
+        return _base != nullptr ? header()->capacity : 0;
+    }
+
+    std::vector<std::string> sensor_names () const
+    {
+        std::vector<std::string> result;
+
+        if (_base != nullptr) {
+            auto h = header();
+
+            for (std::uint32_t i = 0; i < h->sensors; i++)
+                result.emplace_back(h->names[i], strnlen(h->names[i], NAME_SIZE));
+        }
+
+        return result;
+    }
+
+    bool append (float const * values, size_t count, std::int64_t timestamp_ns)
+    {
+        if (!_writable)
+            return false;
+
+        auto h = header();
+        ring_log_record rec;
+        std::memset(& rec, 0, sizeof(rec));
+
+        rec.sensors = static_cast<std::uint32_t>(std::min(count, static_cast<size_t>(h->sensors)));
+        std::memcpy(rec.values, values, rec.sensors * sizeof(float));
+        rec.timestamp_ns = timestamp_ns;
+
+        // Slot is owned by this writer until the ring wraps around
+        rec.seq = __atomic_fetch_add(& h->next_seq, 1, __ATOMIC_RELAXED);
+        rec.checksum = record_checksum(rec);
+
+        std::memcpy(record_at(rec.seq % h->capacity), & rec, sizeof(rec));
+        return true;
+    }
+
+    bool append (pfs::acpi const & a)
+    {
+        if (!_writable)
+            return false;
+
+        float values[ring_log_record::MAX_SENSORS];
+        int scratch[ring_log_record::MAX_SENSORS];
+        auto end = fill_sensor_row(a, _thermal_zones, _batteries, _fans, values, scratch);
+
+        struct timespec ts;
+        clock_gettime(CLOCK_REALTIME, & ts);
+
+        return append(values, static_cast<size_t>(end - values)
+            , static_cast<std::int64_t>(ts.tv_sec) * 1000000000LL + ts.tv_nsec);
+    }
+
+    bool flush (bool wait)
+    {
+        if (!_writable)
+            return false;
+
+        return msync(_base, _size, wait ? MS_SYNC : MS_ASYNC) == 0;
+    }
+
+    std::vector<ring_log_record> records () const
+    {
+        std::vector<ring_log_record> result;
+
+        if (_base == nullptr)
+            return result;
+
+        auto h = header();
+        auto next_seq = __atomic_load_n(& h->next_seq, __ATOMIC_RELAXED);
+
+        for (std::uint32_t i = 0; i < h->capacity; i++) {
+            ring_log_record rec;
+            std::memcpy(& rec, record_at(i), sizeof(rec));
+
+            bool valid = rec.seq < next_seq
+                && rec.seq % h->capacity == i
+                && rec.sensors <= ring_log_record::MAX_SENSORS
+                && rec.checksum == record_checksum(rec);
+
+            if (valid)
+                result.push_back(rec);
+        }
+
+        std::sort(result.begin(), result.end()
+            , [] (ring_log_record const & a, ring_log_record const & b) {
+                return a.seq < b.seq;
+            });
+
+        return result;
+    }
+
+private:
+    // Columns of `append(acpi const &)` are determined by sensor names
+    void count_classes ()
+    {
+        auto h = header();
+
+        for (std::uint32_t i = 0; i < h->sensors; i++) {
+            if (has_sensor_prefix(h->names[i], TEMPERATURE_PREFIX))
+                ++_thermal_zones;
+            else if (has_sensor_prefix(h->names[i], BATTERY_RATE_PREFIX))
+                ++_batteries;
+            else if (has_sensor_prefix(h->names[i], FAN_STATE_PREFIX))
+                ++_fans;
+        }
+    }
+
+    log_header * header () const
+    {
+        return static_cast<log_header *>(_base);
+    }
+
+    void * record_at (std::size_t slot) const
+    {
+        return static_cast<char *>(_base) + HEADER_SIZE + slot * sizeof(ring_log_record);
+    }
+
+private:
+    void * _base {nullptr};
+    std::size_t _size {0};
+    bool _writable {false};
+    size_t _thermal_zones {0};
+    size_t _batteries {0};
+    size_t _fans {0};
+};
+
+} // namespace details
+
+ring_log::ring_log ()
+{
+    _d.reset(new details::ring_log);
+}
+
+ring_log::~ring_log ()
+{}
+
+bool ring_log::open (std::string const & path
+    , size_t capacity
+    , std::vector<std::string> const & sensor_names)
+{
+    return _d->open(path, capacity, sensor_names);
+}
+
+bool ring_log::open (std::string const & path)
+{
+    return _d->open(path);
+}
+
+void ring_log::close ()
+{
+    _d->close();
+}
+
+bool ring_log::is_open () const
+{
+    return _d->is_open();
+}
+
+size_t ring_log::capacity () const
+{
+    return _d->capacity();
+}
+
+std::vector<std::string> ring_log::sensor_names () const
+{
+    return _d->sensor_names();
+}
+
+bool ring_log::append (float const * values, size_t count, std::int64_t timestamp_ns)
+{
+    return _d->append(values, count, timestamp_ns);
+}
+
+bool ring_log::append (acpi const & a)
+{
+    return _d->append(a);
+}
+
+bool ring_log::flush (bool wait)
+{
+    return _d->flush(wait);
+}
+
+std::vector<ring_log_record> ring_log::records () const
+{
+    return _d->records();
+}
+
+std::vector<std::string> ring_log::acpi_sensor_names (acpi const & a)
+{
+    std::vector<std::string> result;
+    details::append_sensor_names(a, result);
+    return result;
+}
+
+} // namespace pfs
@@ -0,0 +1,141 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026 Vladislav Trifochkin
+//
+// This file is part of [pfs-acpi](https://github.com/semenovf/pfs-acpi) library.
+//
+// Changelog:
+//      2026.10.17 Initial version
+//      2026.10.17 Sensor columns are shared with `ring_log`
+////////////////////////////////////////////////////////////////////////////////
+#include "pfs/acpi/sample_recorder.hpp"
+#include "sensor_row.hpp"
+#include <algorithm>
+#include <chrono>
+#include <limits>
+
+namespace pfs {
+
+sample_recorder::sample_recorder (size_t capacity)
+    : _capacity(capacity)
+    , _timestamps(capacity, 0)
+{}
+
+void sample_recorder::clear ()
+{
+    _size = 0;
+    _head = 0;
+    _thermal_zones = 0;
+    _batteries = 0;
+    _fans = 0;
+    _names.clear();
+    _values.clear();
+}
+
+std::int64_t sample_recorder::first_timestamp () const
+{
+    return _size > 0 ? _timestamps[slot(0)] : 0;
+}
+
+std::int64_t sample_recorder::last_timestamp () const
+{
+    return _size > 0 ? _timestamps[slot(_size - 1)] : 0;
+}
+
+void sample_recorder::record (acpi const & a)
+{
+    auto now = std::chrono::steady_clock::now().time_since_epoch();
+    record(a, std::chrono::duration_cast<std::chrono::nanoseconds>(now).count());
+}
+
+void sample_recorder::record (acpi const & a, std::int64_t timestamp_ns)
+{
+    if (_capacity == 0)
+        return;
+
+    // Columns are fixed by the first record
+    if (_names.empty()) {
+        _thermal_zones = a.thermal_zones_available();
+        _batteries = a.batteries_available();
+        _fans = a.fans_available();
+        details::append_sensor_names(a, _names);
+
+        if (_names.empty())
+            return;
+
+        _values.assign(_capacity * _names.size(), 0);
+        _scratch.assign(std::max(_batteries, _fans), 0);
+    }
+
+    if (_size > 0 && timestamp_ns < last_timestamp())
+        return;
+
+    details::fill_sensor_row(a, _thermal_zones, _batteries, _fans
+        , & _values[_head * _names.size()], _scratch.data());
+
+    _timestamps[_head] = timestamp_ns;
+    _head = (_head + 1) % _capacity;
+
+    if (_size < _capacity)
+        ++_size;
+}
+
+size_t sample_recorder::resample (std::int64_t start_ns
+    , std::int64_t step_ns
+    , size_t rows
+    , interpolation_enum interpolation
+    , layout_enum layout
+    , float * out) const
+{
+    auto sensors = _names.size();
+
+    if (_size == 0 || sensors == 0 || rows == 0 || step_ns <= 0)
+        return 0;
+
+    auto nan = std::numeric_limits<float>::quiet_NaN();
+    size_t cursor = 0; // index of the last record with timestamp <= t
+
+    auto store = [&] (size_t r, size_t s, float value) {
+        if (layout == layout_row_major)
+            out[r * sensors + s] = value;
+        else
+            out[s * rows + r] = value;
+    };
+
+    for (size_t r = 0; r < rows; r++) {
+        auto t = start_ns + static_cast<std::int64_t>(r) * step_ns;
+
+        // Timeline is monotonic, so cursor only moves forward
+        while (cursor + 1 < _size && _timestamps[slot(cursor + 1)] <= t)
+            ++cursor;
+
+        auto t0 = _timestamps[slot(cursor)];
+
+        if (t < t0) {
+            for (size_t s = 0; s < sensors; s++)
+                store(r, s, nan);
+
+            continue;
+        }
+
+        auto row0 = & _values[slot(cursor) * sensors];
+        bool has_next = cursor + 1 < _size;
+
+        if (interpolation == interpolation_last_value || !has_next || t == t0) {
+            for (size_t s = 0; s < sensors; s++)
+                store(r, s, row0[s]);
+
+            continue;
+        }
+
+        auto t1 = _timestamps[slot(cursor + 1)];
+        auto row1 = & _values[slot(cursor + 1) * sensors];
+        auto k = static_cast<float>(static_cast<double>(t - t0) / (t1 - t0));
+
+        for (size_t s = 0; s < sensors; s++)
+            store(r, s, row0[s] + (row1[s] - row0[s]) * k);
+    }
+
+    return rows;
+}
+
+} // namespace pfs
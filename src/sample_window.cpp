@@ -0,0 +1,308 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026 Vladislav Trifochkin
+//
+// This file is part of [pfs-acpi](https://github.com/semenovf/pfs-acpi) library.
+//
+// Changelog:
+//      2026.10.17 Initial version
+////////////////////////////////////////////////////////////////////////////////
+#include "pfs/acpi/sample_window.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#   define PFS_ACPI_X86_SIMD 1
+#   include <immintrin.h>
+#endif
+
+namespace pfs {
+
+namespace details {
+
+struct reduction
+{
+    float sum;
+    float min;
+    float max;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+// Scalar kernels
+////////////////////////////////////////////////////////////////////////////////
+static reduction reduce_scalar (float const * p, size_t n)
+{
+    reduction r {0, std::numeric_limits<float>::max(), std::numeric_limits<float>::lowest()};
+
+    for (size_t i = 0; i < n; i++) {
+        r.sum += p[i];
+        r.min = p[i] < r.min ? p[i] : r.min;
+        r.max = p[i] > r.max ? p[i] : r.max;
+    }
+
+    return r;
+}
+
+static float sum_squared_deviations_scalar (float const * p, size_t n, float mean)
+{
+    float result = 0;
+
+    for (size_t i = 0; i < n; i++) {
+        auto d = p[i] - mean;
+        result += d * d;
+    }
+
+    return result;
+}
+
+#if PFS_ACPI_X86_SIMD
+////////////////////////////////////////////////////////////////////////////////
+// SSE2 kernels
+////////////////////////////////////////////////////////////////////////////////
+__attribute__((target("sse2")))
+static float hsum (__m128 v)
+{
+    float buf[4];
+    _mm_storeu_ps(buf, v);
+    return (buf[0] + buf[1]) + (buf[2] + buf[3]);
+}
+
+__attribute__((target("sse2")))
+static reduction reduce_sse2 (float const * p, size_t n)
+{
+    auto sum = _mm_setzero_ps();
+    auto min = _mm_set1_ps(std::numeric_limits<float>::max());
+    auto max = _mm_set1_ps(std::numeric_limits<float>::lowest());
+    size_t i = 0;
+
+    for (; i + 4 <= n; i += 4) {
+        auto v = _mm_loadu_ps(p + i);
+        sum = _mm_add_ps(sum, v);
+        min = _mm_min_ps(min, v);
+        max = _mm_max_ps(max, v);
+    }
+
+    float mins[4], maxs[4];
+    _mm_storeu_ps(mins, min);
+    _mm_storeu_ps(maxs, max);
+
+    auto tail = reduce_scalar(p + i, n - i);
+    reduction r {hsum(sum) + tail.sum, tail.min, tail.max};
+
+    for (int j = 0; j < 4; j++) {
+        r.min = mins[j] < r.min ? mins[j] : r.min;
+        r.max = maxs[j] > r.max ? maxs[j] : r.max;
+    }
+
+    return r;
+}
+
+__attribute__((target("sse2")))
+static float sum_squared_deviations_sse2 (float const * p, size_t n, float mean)
+{
+    auto acc = _mm_setzero_ps();
+    auto m = _mm_set1_ps(mean);
+    size_t i = 0;
+
+    for (; i + 4 <= n; i += 4) {
+        auto d = _mm_sub_ps(_mm_loadu_ps(p + i), m);
+        acc = _mm_add_ps(acc, _mm_mul_ps(d, d));
+    }
+
+    return hsum(acc) + sum_squared_deviations_scalar(p + i, n - i, mean);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// AVX2 kernels
+////////////////////////////////////////////////////////////////////////////////
+__attribute__((target("avx2")))
+static float hsum (__m256 v)
+{
+    float buf[8];
+    _mm256_storeu_ps(buf, v);
+    return ((buf[0] + buf[1]) + (buf[2] + buf[3])) + ((buf[4] + buf[5]) + (buf[6] + buf[7]));
+}
+
+__attribute__((target("avx2")))
+static reduction reduce_avx2 (float const * p, size_t n)
+{
+    auto sum = _mm256_setzero_ps();
+    auto min = _mm256_set1_ps(std::numeric_limits<float>::max());
+    auto max = _mm256_set1_ps(std::numeric_limits<float>::lowest());
+    size_t i = 0;
+
+    for (; i + 8 <= n; i += 8) {
+        auto v = _mm256_loadu_ps(p + i);
+        sum = _mm256_add_ps(sum, v);
+        min = _mm256_min_ps(min, v);
+        max = _mm256_max_ps(max, v);
+    }
+
+    float mins[8], maxs[8];
+    _mm256_storeu_ps(mins, min);
+    _mm256_storeu_ps(maxs, max);
+
+    auto tail = reduce_scalar(p + i, n - i);
+    reduction r {hsum(sum) + tail.sum, tail.min, tail.max};
+
+    for (int j = 0; j < 8; j++) {
+        r.min = mins[j] < r.min ? mins[j] : r.min;
+        r.max = maxs[j] > r.max ? maxs[j] : r.max;
+    }
+
+    return r;
+}
+
+__attribute__((target("avx2")))
+static float sum_squared_deviations_avx2 (float const * p, size_t n, float mean)
+{
+    auto acc = _mm256_setzero_ps();
+    auto m = _mm256_set1_ps(mean);
+    size_t i = 0;
+
+    for (; i + 8 <= n; i += 8) {
+        auto d = _mm256_sub_ps(_mm256_loadu_ps(p + i), m);
+        acc = _mm256_add_ps(acc, _mm256_mul_ps(d, d));
+    }
+
+    return hsum(acc) + sum_squared_deviations_scalar(p + i, n - i, mean);
+}
+#endif // PFS_ACPI_X86_SIMD
+
+static window_stats calculate_stats (float const * p, size_t n, sample_window::simd_enum simd)
+{
+    window_stats result {n, 0, 0, 0, 0};
+
+    if (n == 0)
+        return result;
+
+    reduction r;
+    float ssd = 0;
+
+    switch (simd) {
+#if PFS_ACPI_X86_SIMD
+        case sample_window::simd_avx2:
+            r = reduce_avx2(p, n);
+            result.mean = r.sum / n;
+            ssd = sum_squared_deviations_avx2(p, n, result.mean);
+            break;
+        case sample_window::simd_sse2:
+            r = reduce_sse2(p, n);
+            result.mean = r.sum / n;
+            ssd = sum_squared_deviations_sse2(p, n, result.mean);
+            break;
+#endif
+        default:
+            r = reduce_scalar(p, n);
+            result.mean = r.sum / n;
+            ssd = sum_squared_deviations_scalar(p, n, result.mean);
+            break;
+    }
+
+    result.min = r.min;
+    result.max = r.max;
+    result.stddev = std::sqrt(ssd / n);
+    return result;
+}
+
+} // namespace details
+
+sample_window::sample_window (size_t sensors, size_t capacity)
+    : _sensors(sensors)
+    , _capacity(capacity)
+    , _simd(detected_simd())
+    , _data(sensors * capacity, 0)
+    , _scratch(capacity, 0)
+{}
+
+void sample_window::append (float const * values)
+{
+    if (_capacity == 0)
+        return;
+
+    // Statistics do not depend on samples order, so ring buffer slot is
+    // overwritten in place
+    for (size_t i = 0; i < _sensors; i++)
+        _data[i * _capacity + _head] = values[i];
+
+    _head = (_head + 1) % _capacity;
+
+    if (_size < _capacity)
+        ++_size;
+}
+
+window_stats sample_window::stats (size_t sensor) const
+{
+    if (sensor >= _sensors)
+        return window_stats{0, 0, 0, 0, 0};
+
+    return details::calculate_stats(& _data[sensor * _capacity], _size, _simd);
+}
+
+void sample_window::stats (window_stats * out) const
+{
+    for (size_t i = 0; i < _sensors; i++)
+        out[i] = details::calculate_stats(& _data[i * _capacity], _size, _simd);
+}
+
+float sample_window::percentile (size_t sensor, float p) const
+{
+    if (sensor >= _sensors || _size == 0)
+        return 0;
+
+    p = p < 0 ? 0 : (p > 100 ? 100 : p);
+
+    std::memcpy(_scratch.data(), & _data[sensor * _capacity], _size * sizeof(float));
+
+    auto rank = static_cast<size_t>(std::ceil(p / 100 * _size));
+    auto index = rank > 0 ? rank - 1 : 0;
+    auto nth = _scratch.begin() + index;
+
+    std::nth_element(_scratch.begin(), nth, _scratch.begin() + _size);
+    return *nth;
+}
+
+bool sample_window::set_simd (simd_enum simd)
+{
+    if (simd == simd_auto) {
+        _simd = detected_simd();
+        return true;
+    }
+
+    if (simd == simd_scalar) {
+        _simd = simd;
+        return true;
+    }
+
+    auto detected = detected_simd();
+
+    if (simd == simd_sse2 && (detected == simd_sse2 || detected == simd_avx2)) {
+        _simd = simd;
+        return true;
+    }
+
+    if (simd == simd_avx2 && detected == simd_avx2) {
+        _simd = simd;
+        return true;
+    }
+
+    return false;
+}
+
+sample_window::simd_enum sample_window::detected_simd ()
+{
+#if PFS_ACPI_X86_SIMD
+    __builtin_cpu_init();
+
+    if (__builtin_cpu_supports("avx2"))
+        return simd_avx2;
+
+    if (__builtin_cpu_supports("sse2"))
+        return simd_sse2;
+#endif
+
+    return simd_scalar;
+}
+
+} // namespace pfs
@@ -0,0 +1,79 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026 Vladislav Trifochkin
+//
+// This file is part of [pfs-acpi](https://github.com/semenovf/pfs-acpi) library.
+//
+// Changelog:
+//      2026.10.17 Initial version
+////////////////////////////////////////////////////////////////////////////////
+#pragma once
+#include "pfs/acpi.hpp"
+#include <cstring>
+#include <limits>
+#include <string>
+#include <vector>
+
+namespace pfs {
+namespace details {
+
+// Sensor columns sampled from `acpi` instance: thermal zone temperatures,
+// then battery rates, then fan states.
+static char const TEMPERATURE_PREFIX[] = "temperature:";
+static char const BATTERY_RATE_PREFIX[] = "battery_rate:";
+static char const FAN_STATE_PREFIX[] = "fan_state:";
+
+inline std::string sensor_name (char const * prefix, acpi_string const & name)
+{
+    std::string result {prefix};
+    result.append(name.data(), name.size());
+    return result;
+}
+
+inline bool has_sensor_prefix (char const * name, char const * prefix)
+{
+    return std::strncmp(name, prefix, std::strlen(prefix)) == 0;
+}
+
+// Appends names of all sensor columns in form `<class>:<device>`
+inline void append_sensor_names (pfs::acpi const & a, std::vector<std::string> & names)
+{
+    for (size_t i = 0; i < a.thermal_zones_available(); i++)
+        names.push_back(sensor_name(TEMPERATURE_PREFIX, a.thermal_zone_at(static_cast<int>(i)).name));
+
+    for (size_t i = 0; i < a.batteries_available(); i++)
+        names.push_back(sensor_name(BATTERY_RATE_PREFIX, a.battery_at(static_cast<int>(i)).name));
+
+    for (size_t i = 0; i < a.fans_available(); i++)
+        names.push_back(sensor_name(FAN_STATE_PREFIX, a.fan_at(static_cast<int>(i)).name));
+}
+
+// Fills `thermal_zones + batteries + fans` values of `row`, `scratch` must
+// hold at least `max(batteries, fans)` values. Does not allocate.
+// Returns pointer past the last value filled.
+inline float * fill_sensor_row (pfs::acpi const & a, size_t thermal_zones, size_t batteries
+    , size_t fans, float * row, int * scratch)
+{
+    auto nan = std::numeric_limits<float>::quiet_NaN();
+
+    // Devices missing in this acquisition (e.g. removed battery) are NaN
+    auto n = a.temperatures(row, thermal_zones).count;
+
+    for (size_t i = 0; i < thermal_zones; i++)
+        row[i] = i < n && row[i] != -1 ? row[i] : nan;
+
+    row += thermal_zones;
+    n = a.battery_rates(scratch, batteries).count;
+
+    for (size_t i = 0; i < batteries; i++)
+        row[i] = i < n && scratch[i] >= 0 ? static_cast<float>(scratch[i]) : nan;
+
+    row += batteries;
+    n = a.fan_states(scratch, nullptr, fans).count;
+
+    for (size_t i = 0; i < fans; i++)
+        row[i] = i < n && scratch[i] >= 0 ? static_cast<float>(scratch[i]) : nan;
+
+    return row + fans;
+}
+
+}} // namespace pfs::details
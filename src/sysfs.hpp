@@ -0,0 +1,338 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2020-2026 Vladislav Trifochkin
+//
+// This file is part of [pfs-acpi](https://github.com/semenovf/pfs-acpi) library.
+//
+// Changelog:
+//      2026.10.17 Initial version (helpers moved from acpi_linux.cpp)
+//      2026.10.17 Reads are routed through sysfs tracer when it is enabled
+//      2026.10.17 Latencies of cached attribute reads are recorded
+////////////////////////////////////////////////////////////////////////////////
+#pragma once
+#include "read_latency.hpp"
+#include "sysfs_trace.hpp"
+#include <climits>
+#include <string>
+#include <vector>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <sys/types.h>
+#include <dirent.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace pfs {
+namespace details {
+
+static size_t const BUF_SZ = 64;
+
+inline std::string read_all (std::string const & path, bool remove_trailing_nl = false)
+{
+    auto mode = sysfs_tracer::mode();
+    std::string result;
+
+    if (mode == sysfs_tracer::mode_replay) {
+        auto & tracer = sysfs_tracer::instance();
+        auto id = tracer.entry(trace_kind::file, path);
+
+        if (id < 0 || !tracer.next(id, result))
+            return std::string{};
+    } else {
+        auto input = fopen(path.c_str(), "r");
+
+        if (mode == sysfs_tracer::mode_record && !input) {
+            auto & tracer = sysfs_tracer::instance();
+            tracer.append(tracer.entry(trace_kind::file, path), nullptr, 0, false);
+        }
+
+        if (!input)
+            return std::string{};
+
+        char buf[BUF_SZ];
+        size_t n = 0;
+
+        while ((n = fread(buf, 1, BUF_SZ, input)))
+            result.append(buf, n);
+
+        fclose(input);
+
+        if (mode == sysfs_tracer::mode_record) {
+            auto & tracer = sysfs_tracer::instance();
+            tracer.append(tracer.entry(trace_kind::file, path), result.data(), result.size(), true);
+        }
+    }
+
+    if (remove_trailing_nl && !result.empty() && result.back() == '\n')
+        result.pop_back();
+
+    return result;
+}
+
+// Reads target of symbolic link, returns false on error
+inline bool read_link (std::string const & path, std::string & target)
+{
+    auto mode = sysfs_tracer::mode();
+
+    if (mode == sysfs_tracer::mode_replay) {
+        auto & tracer = sysfs_tracer::instance();
+        auto id = tracer.entry(trace_kind::link, path);
+        return id >= 0 && tracer.next(id, target);
+    }
+
+    char buf[PATH_MAX];
+    auto n = ::readlink(path.c_str(), buf, sizeof(buf) - 1);
+
+    if (mode == sysfs_tracer::mode_record) {
+        auto & tracer = sysfs_tracer::instance();
+        tracer.append(tracer.entry(trace_kind::link, path), buf, n > 0 ? n : 0, n > 0);
+    }
+
+    if (n <= 0)
+        return false;
+
+    target.assign(buf, n);
+    return true;
+}
+
+inline int unit_value (std::string const & s)
+{
+    int n = -1;
+    sscanf(s.c_str(), "%d", & n);
+    return n;
+}
+
+inline bool starts_with (char const * s, char const * prefix)
+{
+    while (*s && *prefix && *s++ == *prefix++)
+        ;
+    return *prefix == '\x0';
+}
+
+inline bool is_dir_entry (struct dirent * de)
+{
+    return !strcmp(de->d_name, ".") || !strcmp(de->d_name, "..");
+}
+
+template <typename Visitor>
+void acquire_devices (char const * direntry, int devices, Visitor && visitor)
+{
+    auto mode = sysfs_tracer::mode();
+
+    // Directory listing is recorded as entries separated by nul character
+    if (mode != sysfs_tracer::mode_off) {
+        auto & tracer = sysfs_tracer::instance();
+        auto id = tracer.entry(trace_kind::dir, direntry);
+        std::string listing;
+
+        if (mode == sysfs_tracer::mode_replay) {
+            if (id < 0 || !tracer.next(id, listing))
+                return;
+        } else {
+            auto d = ::opendir(direntry);
+
+            if (!d) {
+                tracer.append(id, nullptr, 0, false);
+                return;
+            }
+
+            struct dirent * de;
+
+            while ((de = ::readdir(d))) {
+                if (!is_dir_entry(de)) {
+                    listing += de->d_name;
+                    listing += '\x0';
+                }
+            }
+
+            closedir(d);
+            tracer.append(id, listing.data(), listing.size(), true);
+        }
+
+        for (size_t pos = 0; pos < listing.size(); pos = listing.find('\x0', pos) + 1)
+            visitor(listing.c_str() + pos, devices);
+
+        return;
+    }
+
+    auto d = ::opendir(direntry);
+
+    if (!d)
+        return;
+
+    struct dirent * de;
+
+    while ((de = ::readdir(d))) {
+        if (is_dir_entry(de))
+            continue;
+
+        visitor(de->d_name, devices);
+    }
+
+    closedir(d);
+}
+
+//
+// Sysfs attribute with cached file descriptor.
+// Attribute is opened once and re-read with pread() from offset 0, so
+// periodic refresh does not pay for path building and open()/close().
+//
+class sysfs_attribute
+{
+public:
+    sysfs_attribute ()
+    {}
+
+    sysfs_attribute (sysfs_attribute && other) noexcept
+        : _fd(other._fd)
+        , _trace_id(other._trace_id)
+        , _latency(other._latency)
+    {
+        other._fd = -1;
+        other._trace_id = -1;
+        other._latency = nullptr;
+    }
+
+    sysfs_attribute & operator = (sysfs_attribute && other) noexcept
+    {
+        if (this != & other) {
+            close();
+            _fd = other._fd;
+            _trace_id = other._trace_id;
+            _latency = other._latency;
+            other._fd = -1;
+            other._trace_id = -1;
+            other._latency = nullptr;
+        }
+        return *this;
+    }
+
+    sysfs_attribute (sysfs_attribute const &) = delete;
+    sysfs_attribute & operator = (sysfs_attribute const &) = delete;
+
+    ~sysfs_attribute ()
+    {
+        close();
+    }
+
+    // `device` is `acpi::device_enum` value the attribute belongs to,
+    // used to group read latencies.
+    bool open (std::string const & path, int flags = O_RDONLY, int device = 0)
+    {
+        close();
+
+        if (latency_registry::enabled())
+            _latency = latency_registry::slot(path, device);
+
+        auto mode = sysfs_tracer::mode();
+
+        // Replayed attribute has no descriptor
+        if (mode == sysfs_tracer::mode_replay) {
+            auto & tracer = sysfs_tracer::instance();
+            _trace_id = tracer.entry(trace_kind::file, path);
+
+            if (_trace_id >= 0 && !tracer.exists(_trace_id))
+                _trace_id = -1;
+
+            return _trace_id >= 0;
+        }
+
+        _fd = ::open(path.c_str(), flags | O_CLOEXEC);
+
+        if (mode == sysfs_tracer::mode_record) {
+            auto & tracer = sysfs_tracer::instance();
+            _trace_id = tracer.entry(trace_kind::file, path);
+
+            if (_fd < 0)
+                tracer.append(_trace_id, nullptr, 0, false);
+        }
+
+        return _fd >= 0;
+    }
+
+    void close ()
+    {
+        if (_fd >= 0) {
+            ::close(_fd);
+            _fd = -1;
+        }
+
+        _trace_id = -1;
+        _latency = nullptr;
+    }
+
+    bool is_open () const
+    {
+        return _fd >= 0 || _trace_id >= 0;
+    }
+
+    int native_handle () const
+    {
+        return _fd;
+    }
+
+    // Reads attribute value into buffer, terminates it with nul character
+    // and removes trailing new line. Returns length of the value or -1 on error.
+    ssize_t read (char * buf, size_t size) const
+    {
+        if (size == 0)
+            return -1;
+
+        ssize_t n = -1;
+        bool timed = _latency != nullptr && latency_registry::enabled();
+        std::uint64_t start = timed ? latency_clock_ns() : 0;
+
+        if (_fd >= 0) {
+            n = ::pread(_fd, buf, size - 1, 0);
+
+            if (_trace_id >= 0 && sysfs_tracer::mode() == sysfs_tracer::mode_record)
+                sysfs_tracer::instance().append(_trace_id, buf, n > 0 ? n : 0, n >= 0);
+        } else if (_trace_id >= 0) {
+            n = sysfs_tracer::instance().next(_trace_id, buf, size);
+        }
+
+        if (timed)
+            _latency->record(latency_clock_ns() - start);
+
+        if (n < 0)
+            return -1;
+
+        if (n > 0 && buf[n - 1] == '\n')
+            --n;
+
+        buf[n] = '\x0';
+        return n;
+    }
+
+    bool read_int (long long & value) const
+    {
+        char buf[BUF_SZ];
+
+        if (read(buf, sizeof(buf)) <= 0)
+            return false;
+
+        char * endptr = nullptr;
+        value = strtoll(buf, & endptr, 10);
+        return endptr != buf;
+    }
+
+    bool write (char const * s, size_t n) const
+    {
+        if (_fd < 0)
+            return false;
+
+        return ::pwrite(_fd, s, n, 0) == static_cast<ssize_t>(n);
+    }
+
+    bool write (std::string const & s) const
+    {
+        return write(s.c_str(), s.size());
+    }
+
+private:
+    int _fd {-1};
+    int _trace_id {-1}; // entry of sysfs tracer or -1
+    latency_slot * _latency {nullptr};
+};
+
+}} // namespace pfs::details
@@ -0,0 +1,74 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026 Vladislav Trifochkin
+//
+// This file is part of [pfs-acpi](https://github.com/semenovf/pfs-acpi) library.
+//
+// Changelog:
+//      2026.10.17 Initial version
+////////////////////////////////////////////////////////////////////////////////
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace pfs {
+namespace details {
+
+// Whole file reads and re-reads of cached attribute share the same entry,
+// so values recorded by `acquire()` are replayed by `refresh()` too
+enum class trace_kind: std::uint8_t {
+      file //!< file content
+    , dir  //!< directory listing, entries separated by nul character
+    , link //!< symbolic link target
+};
+
+//
+// Process-wide interceptor of sysfs reads used by `pfs::sysfs_trace`.
+// Entries are identified by index, so cached attributes look up their path
+// only once when opened.
+//
+class sysfs_tracer
+{
+public:
+    enum mode_enum { mode_off, mode_record, mode_replay };
+
+public:
+    static sysfs_tracer & instance ();
+
+    // Returns current mode, cheap enough to check on each read
+    static mode_enum mode ()
+    {
+        return static_cast<mode_enum>(_mode.load(std::memory_order_acquire));
+    }
+
+    static void set_mode (mode_enum mode)
+    {
+        _mode.store(mode, std::memory_order_release);
+    }
+
+    // Returns entry index for `path` creating it in record mode,
+    // or -1 if path is absent in replayed trace.
+    int entry (trace_kind kind, std::string const & path);
+
+    // Record mode: appends value read from sysfs, `exists` is false if path
+    // can't be read.
+    void append (int id, char const * data, std::size_t size, bool exists);
+
+    // Returns false if path didn't exist while recording
+    bool exists (int id);
+
+    // Replay mode: copies the next value of the entry into `value` (values are
+    // served in recorded order, cyclically). Returns false if path didn't
+    // exist while recording.
+    bool next (int id, std::string & value);
+
+    // Replay mode: the same as above into buffer of `size` bytes
+    // (including nul character). Returns length of the value or -1.
+    long next (int id, char * buf, std::size_t size);
+
+private:
+    static std::atomic<int> _mode;
+};
+
+}} // namespace pfs::details
@@ -0,0 +1,389 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026 Vladislav Trifochkin
+//
+// This file is part of [pfs-acpi](https://github.com/semenovf/pfs-acpi) library.
+//
+// Changelog:
+//      2026.10.17 Initial version
+////////////////////////////////////////////////////////////////////////////////
+#include "pfs/acpi/sysfs_trace.hpp"
+#include "sysfs_trace.hpp"
+#include <cstdio>
+#include <cstring>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace pfs {
+namespace details {
+
+static char const TRACE_MAGIC[8] = {'P', 'F', 'S', 'T', 'R', 'A', 'C', 'E'};
+static std::uint32_t const TRACE_VERSION = 1;
+
+// Value repeated `repeat` times in a row
+struct trace_value
+{
+    std::string data;
+    std::uint32_t repeat;
+};
+
+struct trace_entry
+{
+    trace_kind kind;
+    bool exists;
+    std::string path;
+    std::vector<trace_value> values;
+
+    // Replay position
+    std::size_t cursor;
+    std::uint32_t cursor_repeat;
+};
+
+struct trace_data
+{
+    std::mutex mutex;
+    std::vector<trace_entry> entries;
+    std::unordered_map<std::string, int> index; // kind + path -> entry
+    std::size_t reads {0};
+    std::size_t misses {0};
+};
+
+std::atomic<int> sysfs_tracer::_mode {sysfs_tracer::mode_off};
+
+static trace_data & data ()
+{
+    static trace_data d;
+    return d;
+}
+
+static std::string index_key (trace_kind kind, std::string const & path)
+{
+    std::string key;
+    key.reserve(path.size() + 1);
+    key += static_cast<char>('0' + static_cast<int>(kind));
+    key += path;
+    return key;
+}
+
+sysfs_tracer & sysfs_tracer::instance ()
+{
+    static sysfs_tracer tracer;
+    return tracer;
+}
+
+int sysfs_tracer::entry (trace_kind kind, std::string const & path)
+{
+    auto & d = data();
+    std::lock_guard<std::mutex> locker(d.mutex);
+    auto key = index_key(kind, path);
+    auto pos = d.index.find(key);
+
+    if (pos != d.index.end())
+        return pos->second;
+
+    if (mode() != mode_record) {
+        ++d.misses;
+        return -1;
+    }
+
+    d.entries.push_back(trace_entry{kind, true, path, {}, 0, 0});
+    auto id = static_cast<int>(d.entries.size() - 1);
+    d.index.emplace(std::move(key), id);
+    return id;
+}
+
+void sysfs_tracer::append (int id, char const * data_ptr, std::size_t size, bool exists)
+{
+    auto & d = data();
+    std::lock_guard<std::mutex> locker(d.mutex);
+
+    if (mode() != mode_record || id < 0 || static_cast<std::size_t>(id) >= d.entries.size())
+        return;
+
+    auto & e = d.entries[id];
+    ++d.reads;
+
+    if (!exists) {
+        e.exists = false;
+        return;
+    }
+
+    e.exists = true;
+
+    if (!e.values.empty() && e.values.back().data.compare(0, std::string::npos, data_ptr, size) == 0)
+        ++e.values.back().repeat;
+    else
+        e.values.push_back(trace_value{std::string(data_ptr, size), 1});
+}
+
+bool sysfs_tracer::exists (int id)
+{
+    auto & d = data();
+    std::lock_guard<std::mutex> locker(d.mutex);
+    return id >= 0 && static_cast<std::size_t>(id) < d.entries.size() && d.entries[id].exists;
+}
+
+// Returns next value of the entry or null, must be called under lock
+static std::string const * advance (trace_data & d, int id)
+{
+    if (id < 0 || static_cast<std::size_t>(id) >= d.entries.size())
+        return nullptr;
+
+    auto & e = d.entries[id];
+
+    if (!e.exists)
+        return nullptr;
+
+    ++d.reads;
+
+    // Entry that was opened but never read
+    if (e.values.empty()) {
+        static std::string const EMPTY;
+        return & EMPTY;
+    }
+
+    auto & value = e.values[e.cursor];
+
+    if (++e.cursor_repeat >= value.repeat) {
+        e.cursor_repeat = 0;
+        e.cursor = (e.cursor + 1) % e.values.size();
+    }
+
+    return & value.data;
+}
+
+bool sysfs_tracer::next (int id, std::string & value)
+{
+    auto & d = data();
+    std::lock_guard<std::mutex> locker(d.mutex);
+    auto p = advance(d, id);
+
+    if (p == nullptr)
+        return false;
+
+    value = *p;
+    return true;
+}
+
+long sysfs_tracer::next (int id, char * buf, std::size_t size)
+{
+    auto & d = data();
+    std::lock_guard<std::mutex> locker(d.mutex);
+    auto p = advance(d, id);
+
+    if (p == nullptr || size == 0)
+        return -1;
+
+    auto n = p->copy(buf, size - 1);
+    return static_cast<long>(n);
+}
+
+template <typename T>
+static bool write_value (FILE * out, T value)
+{
+    return fwrite(& value, sizeof(value), 1, out) == 1;
+}
+
+static bool write_string (FILE * out, std::string const & s)
+{
+    return write_value(out, static_cast<std::uint32_t>(s.size()))
+        && (s.empty() || fwrite(s.data(), 1, s.size(), out) == s.size());
+}
+
+template <typename T>
+static bool read_value (FILE * in, T & value)
+{
+    return fread(& value, sizeof(value), 1, in) == 1;
+}
+
+static bool read_string (FILE * in, std::string & s)
+{
+    std::uint32_t size = 0;
+
+    if (!read_value(in, size))
+        return false;
+
+    s.resize(size);
+    return size == 0 || fread(& s[0], 1, size, in) == size;
+}
+
+}} // namespace pfs::details
+
+namespace pfs {
+
+using details::sysfs_tracer;
+
+void sysfs_trace::record ()
+{
+    sysfs_tracer::set_mode(sysfs_tracer::mode_record);
+}
+
+void sysfs_trace::replay ()
+{
+    rewind();
+    sysfs_tracer::set_mode(sysfs_tracer::mode_replay);
+}
+
+void sysfs_trace::stop ()
+{
+    sysfs_tracer::set_mode(sysfs_tracer::mode_off);
+}
+
+bool sysfs_trace::is_recording ()
+{
+    return sysfs_tracer::mode() == sysfs_tracer::mode_record;
+}
+
+bool sysfs_trace::is_replaying ()
+{
+    return sysfs_tracer::mode() == sysfs_tracer::mode_replay;
+}
+
+void sysfs_trace::clear ()
+{
+    auto & d = details::data();
+    std::lock_guard<std::mutex> locker(d.mutex);
+    d.entries.clear();
+    d.index.clear();
+    d.reads = 0;
+    d.misses = 0;
+}
+
+void sysfs_trace::rewind ()
+{
+    auto & d = details::data();
+    std::lock_guard<std::mutex> locker(d.mutex);
+
+    for (auto & e: d.entries) {
+        e.cursor = 0;
+        e.cursor_repeat = 0;
+    }
+
+    d.reads = 0;
+    d.misses = 0;
+}
+
+//
+// File format (native byte order):
+//      char[8] magic, u32 version, u32 entries_count
+//      entries: u8 kind, u8 exists, u32 path_size, path, u32 values_count
+//      values: u32 repeat, u32 size, data
+//
+bool sysfs_trace::save (std::string const & path)
+{
+    using namespace details;
+
+    auto out = fopen(path.c_str(), "wb");
+
+    if (!out)
+        return false;
+
+    auto & d = data();
+    std::lock_guard<std::mutex> locker(d.mutex);
+
+    bool ok = fwrite(TRACE_MAGIC, sizeof(TRACE_MAGIC), 1, out) == 1
+        && write_value(out, TRACE_VERSION)
+        && write_value(out, static_cast<std::uint32_t>(d.entries.size()));
+
+    for (auto const & e: d.entries) {
+        if (!ok)
+            break;
+
+        ok = write_value(out, static_cast<std::uint8_t>(e.kind))
+            && write_value(out, static_cast<std::uint8_t>(e.exists ? 1 : 0))
+            && write_string(out, e.path)
+            && write_value(out, static_cast<std::uint32_t>(e.values.size()));
+
+        for (auto const & v: e.values) {
+            if (!ok)
+                break;
+
+            ok = write_value(out, v.repeat) && write_string(out, v.data);
+        }
+    }
+
+    return fclose(out) == 0 && ok;
+}
+
+bool sysfs_trace::load (std::string const & path)
+{
+    using namespace details;
+
+    auto in = fopen(path.c_str(), "rb");
+
+    if (!in)
+        return false;
+
+    char magic[8];
+    std::uint32_t version = 0;
+    std::uint32_t count = 0;
+
+    bool ok = fread(magic, sizeof(magic), 1, in) == 1
+        && std::memcmp(magic, TRACE_MAGIC, sizeof(magic)) == 0
+        && read_value(in, version) && version == TRACE_VERSION
+        && read_value(in, count);
+
+    std::vector<trace_entry> entries;
+    std::unordered_map<std::string, int> index;
+
+    for (std::uint32_t i = 0; ok && i < count; i++) {
+        std::uint8_t kind = 0;
+        std::uint8_t exists = 0;
+        std::uint32_t values_count = 0;
+        trace_entry e {trace_kind::file, true, std::string{}, {}, 0, 0};
+
+        ok = read_value(in, kind) && kind <= static_cast<std::uint8_t>(trace_kind::link)
+            && read_value(in, exists)
+            && read_string(in, e.path)
+            && read_value(in, values_count);
+
+        for (std::uint32_t k = 0; ok && k < values_count; k++) {
+            trace_value v {std::string{}, 0};
+            ok = read_value(in, v.repeat) && v.repeat > 0 && read_string(in, v.data);
+            e.values.push_back(std::move(v));
+        }
+
+        if (ok) {
+            e.kind = static_cast<trace_kind>(kind);
+            e.exists = exists != 0;
+            index.emplace(index_key(e.kind, e.path), static_cast<int>(entries.size()));
+            entries.push_back(std::move(e));
+        }
+    }
+
+    fclose(in);
+
+    if (!ok)
+        return false;
+
+    auto & d = data();
+    std::lock_guard<std::mutex> locker(d.mutex);
+    d.entries.swap(entries);
+    d.index.swap(index);
+    d.reads = 0;
+    d.misses = 0;
+    return true;
+}
+
+std::size_t sysfs_trace::paths ()
+{
+    auto & d = details::data();
+    std::lock_guard<std::mutex> locker(d.mutex);
+    return d.entries.size();
+}
+
+std::size_t sysfs_trace::reads ()
+{
+    auto & d = details::data();
+    std::lock_guard<std::mutex> locker(d.mutex);
+    return d.reads;
+}
+
+std::size_t sysfs_trace::misses ()
+{
+    auto & d = details::data();
+    std::lock_guard<std::mutex> locker(d.mutex);
+    return d.misses;
+}
+
+} // namespace pfs
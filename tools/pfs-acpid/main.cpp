@@ -0,0 +1,600 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026 Vladislav Trifochkin
+//
+// This file is part of [pfs-acpi](https://github.com/semenovf/pfs-acpi) library.
+//
+// Changelog:
+//      2026.10.17 Initial version
+////////////////////////////////////////////////////////////////////////////////
+#include "pfs/acpi.hpp"
+#include "pfs/acpi/event.hpp"
+#include "pfs/acpi/monitor_protocol.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <cstdarg>
+#include <chrono>
+#include <cmath>
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <linux/netlink.h>
+#include <poll.h>
+#include <time.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+// Monitoring daemon: owns the only sampler on the host and pushes changed
+// values to clients subscribed over Unix domain socket
+// (see `pfs/acpi/monitor_protocol.hpp`).
+//
+// Usage: pfs-acpid [--socket PATH] [--sysfs-root DIR] [--min-interval MS]
+//          [--no-events] [-v]
+
+namespace {
+
+using clock_type = std::chrono::steady_clock;
+namespace monitor = pfs::monitor;
+
+volatile std::sig_atomic_t g_terminate = 0;
+
+void on_signal (int)
+{
+    g_terminate = 1;
+}
+
+struct value_slot
+{
+    monitor::field_enum field;
+    std::uint16_t index;
+};
+
+struct client
+{
+    int fd;
+    bool subscribed;
+    std::uint32_t fields;
+    clock_type::duration interval;
+    clock_type::time_point next;
+
+    // Values sent last time aligned with daemon slots, next delta carries
+    // all subscribed values if `full` is true
+    std::vector<std::int32_t> last;
+    bool full;
+};
+
+class monitor_daemon
+{
+public:
+    monitor_daemon (std::string const & sysfs_root, int min_interval_ms, bool verbose)
+        : _acpi(sysfs_root)
+        , _min_interval(std::chrono::milliseconds(min_interval_ms))
+        , _verbose(verbose)
+    {}
+
+    ~monitor_daemon ()
+    {
+        for (auto const & c: _clients)
+            ::close(c.fd);
+
+        if (_uevent_fd >= 0)
+            ::close(_uevent_fd);
+
+        if (_listen_fd >= 0) {
+            ::close(_listen_fd);
+            unlink(_socket_path.c_str());
+        }
+    }
+
+    bool listen (std::string const & socket_path)
+    {
+        struct sockaddr_un addr;
+        std::memset(& addr, 0, sizeof(addr));
+        addr.sun_family = AF_UNIX;
+
+        if (socket_path.size() >= sizeof(addr.sun_path))
+            return false;
+
+        socket_path.copy(addr.sun_path, socket_path.size());
+
+        _listen_fd = socket(AF_UNIX, SOCK_SEQPACKET | SOCK_CLOEXEC | SOCK_NONBLOCK, 0);
+
+        if (_listen_fd < 0)
+            return false;
+
+        // Remove stale socket of the previous instance
+        unlink(socket_path.c_str());
+
+        if (bind(_listen_fd, reinterpret_cast<struct sockaddr *>(& addr), sizeof(addr)) != 0
+                || ::listen(_listen_fd, 16) != 0) {
+            ::close(_listen_fd);
+            _listen_fd = -1;
+            return false;
+        }
+
+        _socket_path = socket_path;
+        return true;
+    }
+
+    // Event sources are optional, daemon falls back to periodic sampling
+    void open_event_sources ()
+    {
+        if (!_events.open())
+            log("ACPI events are not available");
+
+        _uevent_fd = socket(AF_NETLINK, SOCK_DGRAM | SOCK_CLOEXEC | SOCK_NONBLOCK
+            , NETLINK_KOBJECT_UEVENT);
+
+        if (_uevent_fd >= 0) {
+            struct sockaddr_nl local;
+            std::memset(& local, 0, sizeof(local));
+            local.nl_family = AF_NETLINK;
+            local.nl_groups = 1; // kernel uevents
+
+            if (bind(_uevent_fd, reinterpret_cast<struct sockaddr *>(& local), sizeof(local)) != 0) {
+                ::close(_uevent_fd);
+                _uevent_fd = -1;
+            }
+        }
+
+        if (_uevent_fd < 0)
+            log("uevents are not available");
+    }
+
+    void run ()
+    {
+        acquire();
+
+        std::vector<struct pollfd> pfds;
+
+        while (!g_terminate) {
+            pfds.clear();
+            pfds.push_back(pollfd{_listen_fd, POLLIN, 0});
+            pfds.push_back(pollfd{_events.native_handle(), POLLIN, 0});
+            pfds.push_back(pollfd{_uevent_fd, POLLIN, 0});
+
+            for (auto const & c: _clients)
+                pfds.push_back(pollfd{c.fd, POLLIN, 0});
+
+            auto rc = poll(pfds.data(), pfds.size(), timeout_ms());
+
+            if (rc < 0) {
+                if (errno == EINTR)
+                    continue;
+
+                log("poll failure: %s", strerror(errno));
+                break;
+            }
+
+            // Clients are processed first, the list is changed by accept
+            // and disconnection
+            for (size_t i = pfds.size(); i > 3; i--) {
+                if (pfds[i - 1].revents != 0)
+                    process_client(i - 4);
+            }
+
+            if (pfds[0].revents & POLLIN)
+                accept_clients();
+
+            if (pfds[1].revents & POLLIN) {
+                if (_events.process(_acpi) > 0)
+                    push_all();
+            }
+
+            if (pfds[2].revents & POLLIN)
+                process_uevents();
+
+            push_due();
+        }
+    }
+
+private:
+    void log (char const * format, ...)
+    {
+        va_list args;
+        va_start(args, format);
+        fprintf(stderr, "pfs-acpid: ");
+        vfprintf(stderr, format, args);
+        fprintf(stderr, "\n");
+        va_end(args);
+    }
+
+    // Sampler sleeps while there are no subscribers
+    int timeout_ms () const
+    {
+        bool found = false;
+        clock_type::time_point next;
+
+        for (auto const & c: _clients) {
+            if (c.subscribed && (!found || c.next < next)) {
+                next = c.next;
+                found = true;
+            }
+        }
+
+        if (!found)
+            return -1;
+
+        auto timeout = std::chrono::duration_cast<std::chrono::milliseconds>(next - clock_type::now()).count();
+        return timeout > 0 ? static_cast<int>(timeout) + 1 : 0;
+    }
+
+    // (Re)acquires devices and announces new set of devices to clients
+    void acquire ()
+    {
+        _acpi.acquire(pfs::acpi::dev_all);
+        _names.clear();
+
+        auto add_name = [this] (monitor::device_class_enum device_class, size_t index, char const * name, size_t size) {
+            monitor::name_entry entry;
+            std::memset(& entry, 0, sizeof(entry));
+            entry.device_class = device_class;
+            entry.index = static_cast<std::uint16_t>(index);
+            std::memcpy(entry.name, name, std::min(size, sizeof(entry.name) - 1));
+            _names.push_back(entry);
+        };
+
+        for (size_t i = 0; i < _acpi.batteries_available(); i++) {
+            auto name = _acpi.battery_at(static_cast<int>(i)).name;
+            add_name(monitor::class_battery, i, name.c_str(), name.size());
+        }
+
+        for (size_t i = 0; i < _acpi.ac_adapters_available(); i++) {
+            auto name = _acpi.ac_adapter_at(static_cast<int>(i)).name;
+            add_name(monitor::class_ac_adapter, i, name.c_str(), name.size());
+        }
+
+        for (size_t i = 0; i < _acpi.thermal_zones_available(); i++) {
+            auto name = _acpi.thermal_zone_at(static_cast<int>(i)).name;
+            add_name(monitor::class_thermal_zone, i, name.c_str(), name.size());
+        }
+
+        for (size_t i = 0; i < _acpi.fans_available(); i++) {
+            auto name = _acpi.fan_at(static_cast<int>(i)).name;
+            add_name(monitor::class_fan, i, name.c_str(), name.size());
+        }
+
+        collect();
+
+        for (size_t i = _clients.size(); i > 0; i--) {
+            if (_clients[i - 1].subscribed && !send_names(i - 1))
+                disconnect(i - 1);
+        }
+
+        log("%zu devices acquired", _names.size());
+    }
+
+    // Fills slots and values from the last acquisition
+    void collect ()
+    {
+        _slots.clear();
+        _values.clear();
+
+        auto add = [this] (monitor::field_enum field, size_t index, int value) {
+            _slots.push_back(value_slot{field, static_cast<std::uint16_t>(index)});
+            _values.push_back(value >= 0 ? value : monitor::VALUE_UNAVAILABLE);
+        };
+
+        auto count = _acpi.batteries_available();
+        _scratch.resize(std::max(count, _acpi.fans_available()) * 2);
+        count = _acpi.battery_rates(_scratch.data(), count).count;
+
+        for (size_t i = 0; i < count; i++) {
+            auto bat = _acpi.battery_at(static_cast<int>(i));
+            add(monitor::field_battery_percentage, i, bat.percentage);
+            add(monitor::field_battery_seconds, i, bat.seconds);
+            add(monitor::field_battery_rate, i, _scratch[i]);
+            add(monitor::field_battery_charge_state, i, static_cast<int>(bat.charge_state));
+        }
+
+        for (size_t i = 0; i < _acpi.ac_adapters_available(); i++) {
+            auto state = _acpi.ac_adapter_at(static_cast<int>(i)).state;
+            add(monitor::field_ac_online, i, state == pfs::ac_state_enum::unknown
+                ? -1 : state == pfs::ac_state_enum::online ? 1 : 0);
+        }
+
+        count = _acpi.thermal_zones_available();
+        _temperatures.resize(count);
+        count = _acpi.temperatures(_temperatures.data(), count).count;
+
+        for (size_t i = 0; i < count; i++) {
+            _slots.push_back(value_slot{monitor::field_temperature, static_cast<std::uint16_t>(i)});
+            _values.push_back(_temperatures[i] != -1
+                ? static_cast<std::int32_t>(std::lround(_temperatures[i] * 1000))
+                : monitor::VALUE_UNAVAILABLE);
+        }
+
+        count = _acpi.fans_available();
+        count = _acpi.fan_states(_scratch.data(), _scratch.data() + count, count).count;
+
+        for (size_t i = 0; i < count; i++) {
+            add(monitor::field_fan_cur_state, i, _scratch[i]);
+            add(monitor::field_fan_max_state, i, _scratch[_acpi.fans_available() + i]);
+        }
+    }
+
+    void accept_clients ()
+    {
+        int fd;
+
+        while ((fd = accept4(_listen_fd, nullptr, nullptr, SOCK_CLOEXEC | SOCK_NONBLOCK)) >= 0) {
+            _clients.push_back(client{fd, false, 0, _min_interval, clock_type::now(), {}, true});
+
+            if (_verbose)
+                log("client %d connected", fd);
+        }
+    }
+
+    void disconnect (size_t index)
+    {
+        if (_verbose)
+            log("client %d disconnected", _clients[index].fd);
+
+        ::close(_clients[index].fd);
+        _clients.erase(_clients.begin() + static_cast<std::ptrdiff_t>(index));
+    }
+
+    void process_client (size_t index)
+    {
+        monitor::subscribe_request req;
+        auto n = recv(_clients[index].fd, & req, sizeof(req), 0);
+
+        if (n < 0 && (errno == EAGAIN || errno == EINTR))
+            return;
+
+        if (n != sizeof(req) || req.header.type != monitor::msg_subscribe
+                || req.header.version != monitor::PROTOCOL_VERSION) {
+            disconnect(index);
+            return;
+        }
+
+        auto & c = _clients[index];
+        c.subscribed = true;
+        c.fields = req.fields & monitor::ALL_FIELDS;
+        c.interval = std::max<clock_type::duration>(std::chrono::milliseconds(req.interval_ms), _min_interval);
+        c.next = clock_type::now();
+
+        if (_verbose) {
+            log("client %d subscribed: fields 0x%x, interval %u ms", c.fd
+                , c.fields, req.interval_ms);
+        }
+
+        if (!send_names(index))
+            disconnect(index);
+    }
+
+    bool send_message (size_t index, void const * data, size_t size, bool droppable)
+    {
+        auto & c = _clients[index];
+        auto n = send(c.fd, data, size, MSG_NOSIGNAL | MSG_DONTWAIT);
+
+        if (n == static_cast<ssize_t>(size))
+            return true;
+
+        // Slow client: delta is dropped and all values are resent next time
+        if (n < 0 && errno == EAGAIN && droppable) {
+            c.full = true;
+            return true;
+        }
+
+        return false;
+    }
+
+    // Returns false if client must be disconnected
+    bool send_names (size_t index)
+    {
+        _out.resize(sizeof(monitor::message_header) + _names.size() * sizeof(monitor::name_entry));
+
+        monitor::message_header header {monitor::msg_names, monitor::PROTOCOL_VERSION
+            , static_cast<std::uint32_t>(_names.size())};
+
+        std::memcpy(_out.data(), & header, sizeof(header));
+
+        if (!_names.empty()) {
+            std::memcpy(_out.data() + sizeof(header), _names.data()
+                , _names.size() * sizeof(monitor::name_entry));
+        }
+
+        _clients[index].full = true;
+        _clients[index].next = clock_type::now();
+
+        return send_message(index, _out.data(), _out.size(), false);
+    }
+
+    // Sends values changed since the previous delta, returns false if client
+    // must be disconnected
+    bool send_delta (size_t index)
+    {
+        auto & c = _clients[index];
+        bool full = c.full || c.last.size() != _values.size();
+
+        if (c.last.size() != _values.size())
+            c.last.assign(_values.size(), monitor::VALUE_UNAVAILABLE);
+
+        _out.resize(sizeof(monitor::delta_header) + _values.size() * sizeof(monitor::delta_entry));
+        std::uint32_t count = 0;
+        auto entries = _out.data() + sizeof(monitor::delta_header);
+
+        for (size_t i = 0; i < _values.size(); i++) {
+            if (!(c.fields & monitor::field_bit(_slots[i].field)))
+                continue;
+
+            if (!full && c.last[i] == _values[i])
+                continue;
+
+            monitor::delta_entry entry {_slots[i].field, 0, _slots[i].index, _values[i]};
+            std::memcpy(entries + count * sizeof(entry), & entry, sizeof(entry));
+            c.last[i] = _values[i];
+            ++count;
+        }
+
+        c.full = false;
+
+        // Nothing changed
+        if (count == 0 && !full)
+            return true;
+
+        struct timespec ts;
+        clock_gettime(CLOCK_REALTIME, & ts);
+
+        monitor::delta_header header;
+        header.header = monitor::message_header{monitor::msg_delta, monitor::PROTOCOL_VERSION, count};
+        header.generation = _acpi.generation();
+        header.timestamp_ns = static_cast<std::int64_t>(ts.tv_sec) * 1000000000LL + ts.tv_nsec;
+        std::memcpy(_out.data(), & header, sizeof(header));
+
+        return send_message(index, _out.data()
+            , sizeof(monitor::delta_header) + count * sizeof(monitor::delta_entry), true);
+    }
+
+    // Samples once for all clients due by now
+    void push_due ()
+    {
+        auto now = clock_type::now();
+        bool sampled = false;
+
+        for (size_t i = _clients.size(); i > 0; i--) {
+            auto & c = _clients[i - 1];
+
+            if (!c.subscribed || c.next > now)
+                continue;
+
+            if (!sampled) {
+                _acpi.refresh(pfs::acpi::dev_all);
+                collect();
+                sampled = true;
+            }
+
+            c.next += c.interval;
+
+            if (c.next <= now)
+                c.next = now + c.interval;
+
+            if (!send_delta(i - 1))
+                disconnect(i - 1);
+        }
+    }
+
+    // Pushes changes caused by event to all subscribers immediately
+    void push_all ()
+    {
+        collect();
+
+        for (size_t i = _clients.size(); i > 0; i--) {
+            if (_clients[i - 1].subscribed && !send_delta(i - 1))
+                disconnect(i - 1);
+        }
+    }
+
+    void process_uevents ()
+    {
+        char buf[8192];
+        bool reacquire = false;
+        int refresh_devices = pfs::acpi::dev_none;
+        ssize_t n;
+
+        while ((n = recv(_uevent_fd, buf, sizeof(buf) - 1, MSG_DONTWAIT)) > 0) {
+            buf[n] = '\x0';
+
+            // Message is `ACTION@DEVPATH` followed by nul-separated `KEY=VALUE` pairs
+            char const * action = nullptr;
+            char const * subsystem = nullptr;
+
+            for (char * p = buf; p < buf + n; p += strlen(p) + 1) {
+                if (strncmp(p, "ACTION=", 7) == 0)
+                    action = p + 7;
+                else if (strncmp(p, "SUBSYSTEM=", 10) == 0)
+                    subsystem = p + 10;
+            }
+
+            if (action == nullptr || subsystem == nullptr)
+                continue;
+
+            int devices = strcmp(subsystem, "power_supply") == 0 ? pfs::acpi::dev_power_supply
+                : strcmp(subsystem, "thermal") == 0 ? pfs::acpi::dev_thermal
+                : pfs::acpi::dev_none;
+
+            if (devices == pfs::acpi::dev_none)
+                continue;
+
+            if (strcmp(action, "add") == 0 || strcmp(action, "remove") == 0)
+                reacquire = true;
+            else if (strcmp(action, "change") == 0)
+                refresh_devices |= devices;
+        }
+
+        if (reacquire) {
+            acquire();
+        } else if (refresh_devices != pfs::acpi::dev_none) {
+            _acpi.refresh(refresh_devices);
+            push_all();
+        }
+    }
+
+private:
+    pfs::acpi _acpi;
+    pfs::acpi_event_listener _events;
+    clock_type::duration _min_interval;
+    bool _verbose;
+    std::string _socket_path;
+    int _listen_fd {-1};
+    int _uevent_fd {-1};
+    std::vector<client> _clients;
+    std::vector<monitor::name_entry> _names;
+    std::vector<value_slot> _slots;
+    std::vector<std::int32_t> _values;
+    std::vector<int> _scratch;
+    std::vector<float> _temperatures;
+    std::vector<char> _out;
+};
+
+} // namespace
+
+int main (int argc, char * argv[])
+{
+    std::string socket_path {monitor::DEFAULT_SOCKET_PATH};
+    std::string sysfs_root {"/sys"};
+    int min_interval_ms = 100;
+    bool events = true;
+    bool verbose = false;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--socket") == 0 && i + 1 < argc) {
+            socket_path = argv[++i];
+        } else if (strcmp(argv[i], "--sysfs-root") == 0 && i + 1 < argc) {
+            sysfs_root = argv[++i];
+        } else if (strcmp(argv[i], "--min-interval") == 0 && i + 1 < argc) {
+            min_interval_ms = std::max(atoi(argv[++i]), 1);
+        } else if (strcmp(argv[i], "--no-events") == 0) {
+            events = false;
+        } else if (strcmp(argv[i], "-v") == 0) {
+            verbose = true;
+        } else {
+            fprintf(stderr, "Usage: %s [--socket PATH] [--sysfs-root DIR]"
+                " [--min-interval MS] [--no-events] [-v]\n", argv[0]);
+            return EXIT_FAILURE;
+        }
+    }
+
+    struct sigaction sa;
+    std::memset(& sa, 0, sizeof(sa));
+    sa.sa_handler = on_signal;
+    sigaction(SIGINT, & sa, nullptr);
+    sigaction(SIGTERM, & sa, nullptr);
+
+    monitor_daemon d {sysfs_root, min_interval_ms, verbose};
+
+    if (!d.listen(socket_path)) {
+        fprintf(stderr, "pfs-acpid: failed to listen on %s: %s\n", socket_path.c_str(), strerror(errno));
+        return EXIT_FAILURE;
+    }
+
+    if (events)
+        d.open_event_sources();
+
+    d.run();
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,658 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026 Vladislav Trifochkin
+//
+// This file is part of [pfs-acpi](https://github.com/semenovf/pfs-acpi) library.
+//
+// Changelog:
+//      2026.10.17 Initial version
+////////////////////////////////////////////////////////////////////////////////
+#include "pfs/acpi.hpp"
+#include "pfs/acpi/monitor_protocol.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <cmath>
+#include <csignal>
+#include <cstdarg>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <fcntl.h>
+#include <time.h>
+#include <sys/resource.h>
+#include <unistd.h>
+
+// vmstat-style sampler: prints one line per sample with selected readings.
+//
+// Usage: pfs-acpistat [-i SECONDS] [-n COUNT] [-c CLASSES] [-f FIELDS]
+//          [--csv | --json] [--overhead] [--sysfs-root DIR]
+//
+//      -i SECONDS   interval between samples (fractions allowed, default 1)
+//      -n COUNT     number of samples (default 0 - until interrupted)
+//      -c CLASSES   comma separated device classes: bat, ac, tz, fan
+//      -f FIELDS    comma separated fields: pct, sec, rate, state, online,
+//                   temp, fan, fanmax (overrides -c)
+//      --csv        comma separated values with header line
+//      --json       one JSON object per sample
+//      --overhead   print CPU time and syscalls of the tool on exit (stderr)
+//
+// Devices are acquired once at startup, samples are re-read through cached
+// attribute descriptors (`acpi::refresh()`). Each line is formatted into
+// reusable buffer and written by single write() call.
+
+namespace {
+
+namespace monitor = pfs::monitor;
+
+volatile std::sig_atomic_t g_terminate = 0;
+
+void on_signal (int)
+{
+    g_terminate = 1;
+}
+
+enum format_enum { format_text, format_csv, format_json };
+
+struct field_info
+{
+    monitor::field_enum field;
+    char const * name;   // command line and header name
+    char const * key;    // JSON key
+};
+
+field_info const FIELDS[] = {
+      {monitor::field_battery_percentage,   "pct",    "percentage"}
+    , {monitor::field_battery_seconds,      "sec",    "seconds"}
+    , {monitor::field_battery_rate,         "rate",   "rate"}
+    , {monitor::field_battery_charge_state, "state",  "charge_state"}
+    , {monitor::field_ac_online,            "online", "online"}
+    , {monitor::field_temperature,          "temp",   "temperature"}
+    , {monitor::field_fan_cur_state,        "fan",    "cur_state"}
+    , {monitor::field_fan_max_state,        "fanmax", "max_state"}
+};
+
+struct class_info
+{
+    char const * name;
+    int devices;
+};
+
+class_info const CLASSES[] = {
+      {"bat", pfs::acpi::dev_battery}
+    , {"ac",  pfs::acpi::dev_ac_adapter}
+    , {"tz",  pfs::acpi::dev_thermal_zone}
+    , {"fan", pfs::acpi::dev_fan}
+};
+
+char const * CHARGE_STATES[] = {"unknown", "charge", "discharge", "charged"};
+
+struct column
+{
+    monitor::field_enum field;
+    std::size_t index;   // device index within class
+    std::string device;  // device name
+    std::string header;  // `<device>.<field name>`
+    int width;
+};
+
+// Calls `f` for each item of comma separated list, returns false if `f` fails
+template <typename F>
+bool for_each_item (char const * list, F && f)
+{
+    std::string item;
+
+    for (char const * p = list; ; p++) {
+        if (*p == ',' || *p == '\x0') {
+            if (!item.empty() && !f(item))
+                return false;
+
+            item.clear();
+
+            if (*p == '\x0')
+                break;
+        } else {
+            item += *p;
+        }
+    }
+
+    return true;
+}
+
+// Counters of read and write syscalls from /proc/self/io
+struct io_counters
+{
+    long long syscr {-1};
+    long long syscw {-1};
+};
+
+io_counters read_io_counters ()
+{
+    io_counters result;
+    char buf[512];
+    auto fd = open("/proc/self/io", O_RDONLY | O_CLOEXEC);
+
+    if (fd < 0)
+        return result;
+
+    auto n = read(fd, buf, sizeof(buf) - 1);
+    close(fd);
+
+    if (n <= 0)
+        return result;
+
+    buf[n] = '\x0';
+
+    if (auto p = strstr(buf, "syscr:"))
+        result.syscr = atoll(p + 6);
+
+    if (auto p = strstr(buf, "syscw:"))
+        result.syscw = atoll(p + 6);
+
+    return result;
+}
+
+double monotonic_seconds ()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, & ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+double cpu_seconds (struct timeval const & tv)
+{
+    return tv.tv_sec + tv.tv_usec / 1e6;
+}
+
+class sampler
+{
+public:
+    sampler (std::string const & sysfs_root, std::uint32_t fields, format_enum format)
+        : _acpi(sysfs_root)
+        , _fields(fields)
+        , _format(format)
+    {
+        _devices = 0;
+
+        for (int f = 0; f < monitor::field_count; f++) {
+            if (fields & monitor::field_bit(static_cast<monitor::field_enum>(f)))
+                _devices |= device_of(monitor::class_of(static_cast<monitor::field_enum>(f)));
+        }
+
+        _acpi.acquire(_devices);
+        build_columns();
+
+        _values.resize(_columns.size());
+        _rates.resize(_acpi.batteries_available());
+        _temperatures.resize(_acpi.thermal_zones_available());
+        _cur_states.resize(_acpi.fans_available());
+        _max_states.resize(_acpi.fans_available());
+        _out.reserve(4096);
+    }
+
+    std::size_t columns () const
+    {
+        return _columns.size();
+    }
+
+    void print_header ()
+    {
+        _out.clear();
+
+        if (_format == format_text) {
+            append("%9s", "time");
+
+            for (auto const & c: _columns)
+                append(" %*s", c.width, c.header.c_str());
+        } else if (_format == format_csv) {
+            append("timestamp");
+
+            for (auto const & c: _columns)
+                append(",%s", c.header.c_str());
+        } else {
+            return;
+        }
+
+        append("\n");
+        flush();
+    }
+
+    void sample (double elapsed)
+    {
+        _acpi.refresh(_devices);
+        collect();
+
+        _out.clear();
+
+        if (_format == format_text)
+            format_text_line(elapsed);
+        else if (_format == format_csv)
+            format_csv_line();
+        else
+            format_json_line();
+
+        flush();
+    }
+
+private:
+    static int device_of (monitor::device_class_enum cls)
+    {
+        switch (cls) {
+            case monitor::class_battery: return pfs::acpi::dev_battery;
+            case monitor::class_ac_adapter: return pfs::acpi::dev_ac_adapter;
+            case monitor::class_thermal_zone: return pfs::acpi::dev_thermal_zone;
+            default: break;
+        }
+
+        return pfs::acpi::dev_fan;
+    }
+
+    void build_columns ()
+    {
+        std::vector<std::string> names[monitor::class_count];
+
+        for (std::size_t i = 0; i < _acpi.batteries_available(); i++)
+            names[monitor::class_battery].emplace_back(_acpi.battery_at(static_cast<int>(i)).name.c_str());
+
+        for (std::size_t i = 0; i < _acpi.ac_adapters_available(); i++)
+            names[monitor::class_ac_adapter].emplace_back(_acpi.ac_adapter_at(static_cast<int>(i)).name.c_str());
+
+        for (std::size_t i = 0; i < _acpi.thermal_zones_available(); i++)
+            names[monitor::class_thermal_zone].emplace_back(_acpi.thermal_zone_at(static_cast<int>(i)).name.c_str());
+
+        for (std::size_t i = 0; i < _acpi.fans_available(); i++)
+            names[monitor::class_fan].emplace_back(_acpi.fan_at(static_cast<int>(i)).name.c_str());
+
+        // Columns are grouped by device
+        for (int cls = 0; cls < monitor::class_count; cls++) {
+            for (std::size_t i = 0; i < names[cls].size(); i++) {
+                for (auto const & f: FIELDS) {
+                    if (monitor::class_of(f.field) != cls || !(_fields & monitor::field_bit(f.field)))
+                        continue;
+
+                    column c;
+                    c.field = f.field;
+                    c.index = i;
+                    c.device = names[cls][i];
+                    c.header = c.device + '.' + f.name;
+                    c.width = std::max(static_cast<int>(c.header.size())
+                        , f.field == monitor::field_battery_charge_state ? 9 : 6);
+                    _columns.push_back(std::move(c));
+                }
+            }
+        }
+    }
+
+    // Stores readings in column order, temperature in millidegrees
+    void collect ()
+    {
+        auto battery_count = _acpi.battery_rates(_rates.data(), _rates.size()).count;
+        auto zone_count = _acpi.temperatures(_temperatures.data(), _temperatures.size()).count;
+        auto fan_count = _acpi.fan_states(_cur_states.data(), _max_states.data(), _cur_states.size()).count;
+
+        // Battery and AC adapter accessors are called once per device
+        int battery_index = -1;
+        int percentage = -1;
+        int seconds = -1;
+        int charge_state = 0;
+        int ac_index = -1;
+        int online = -1;
+
+        for (std::size_t i = 0; i < _columns.size(); i++) {
+            auto const & c = _columns[i];
+            auto index = static_cast<int>(c.index);
+            std::int32_t value = -1;
+
+            switch (monitor::class_of(c.field)) {
+                case monitor::class_battery:
+                    if (c.index >= battery_count)
+                        break;
+
+                    if (battery_index != index) {
+                        auto bat = _acpi.battery_at(index);
+                        battery_index = index;
+                        percentage = bat.percentage;
+                        seconds = bat.seconds;
+                        charge_state = static_cast<int>(bat.charge_state);
+                    }
+
+                    value = c.field == monitor::field_battery_percentage ? percentage
+                        : c.field == monitor::field_battery_seconds ? seconds
+                        : c.field == monitor::field_battery_rate ? _rates[c.index]
+                        : charge_state;
+                    break;
+
+                case monitor::class_ac_adapter:
+                    if (ac_index != index) {
+                        auto state = _acpi.ac_adapter_at(index).state;
+                        ac_index = index;
+                        online = state == pfs::ac_state_enum::unknown
+                            ? -1 : state == pfs::ac_state_enum::online ? 1 : 0;
+                    }
+
+                    value = online;
+                    break;
+
+                case monitor::class_thermal_zone:
+                    if (c.index < zone_count && _temperatures[c.index] != -1)
+                        value = static_cast<std::int32_t>(std::lround(_temperatures[c.index] * 1000));
+                    else
+                        value = monitor::VALUE_UNAVAILABLE;
+                    break;
+
+                default:
+                    if (c.index < fan_count)
+                        value = c.field == monitor::field_fan_cur_state
+                            ? _cur_states[c.index] : _max_states[c.index];
+                    break;
+            }
+
+            _values[i] = value;
+        }
+    }
+
+    bool available (std::size_t i) const
+    {
+        return _columns[i].field == monitor::field_temperature
+            ? _values[i] != monitor::VALUE_UNAVAILABLE
+            : _values[i] >= 0;
+    }
+
+    // Formats value of column `i` into `buf`
+    char const * format_value (std::size_t i, char const * unavailable, char * buf, std::size_t size) const
+    {
+        auto value = _values[i];
+
+        if (!available(i))
+            return unavailable;
+
+        if (_columns[i].field == monitor::field_temperature) {
+            snprintf(buf, size, "%.1f", value / 1000.0);
+        } else if (_columns[i].field == monitor::field_battery_charge_state) {
+            auto s = value < 4 ? CHARGE_STATES[value] : CHARGE_STATES[0];
+            snprintf(buf, size, _format == format_json ? "\"%s\"" : "%s", s);
+        } else {
+            snprintf(buf, size, "%d", value);
+        }
+
+        return buf;
+    }
+
+    void format_text_line (double elapsed)
+    {
+        char buf[32];
+
+        append("%9.3f", elapsed);
+
+        for (std::size_t i = 0; i < _columns.size(); i++)
+            append(" %*s", _columns[i].width, format_value(i, "-", buf, sizeof(buf)));
+
+        append("\n");
+    }
+
+    void format_csv_line ()
+    {
+        char buf[32];
+
+        append("%.3f", realtime_seconds());
+
+        for (std::size_t i = 0; i < _columns.size(); i++)
+            append(",%s", format_value(i, "", buf, sizeof(buf)));
+
+        append("\n");
+    }
+
+    // {"timestamp":...,"<device>":{"<key>":value,...},...}
+    void format_json_line ()
+    {
+        char buf[32];
+
+        append("{\"timestamp\":%.3f", realtime_seconds());
+
+        for (std::size_t i = 0; i < _columns.size(); i++) {
+            auto const & c = _columns[i];
+            bool first = i == 0 || _columns[i - 1].device != c.device
+                || _columns[i - 1].index != c.index;
+
+            if (first)
+                append(",\"%s\":{", c.device.c_str());
+            else
+                append(",");
+
+            append("\"%s\":%s", key_of(c.field), format_value(i, "null", buf, sizeof(buf)));
+
+            bool last = i + 1 == _columns.size() || _columns[i + 1].device != c.device
+                || _columns[i + 1].index != c.index;
+
+            if (last)
+                append("}");
+        }
+
+        append("}\n");
+    }
+
+    static char const * key_of (monitor::field_enum field)
+    {
+        for (auto const & f: FIELDS) {
+            if (f.field == field)
+                return f.key;
+        }
+
+        return "";
+    }
+
+    static double realtime_seconds ()
+    {
+        struct timespec ts;
+        clock_gettime(CLOCK_REALTIME, & ts);
+        return ts.tv_sec + ts.tv_nsec / 1e9;
+    }
+
+    void append (char const * format, ...)
+    {
+        char buf[128];
+        va_list args;
+        va_start(args, format);
+        auto n = vsnprintf(buf, sizeof(buf), format, args);
+        va_end(args);
+
+        if (n > 0)
+            _out.insert(_out.end(), buf, buf + std::min(static_cast<std::size_t>(n), sizeof(buf) - 1));
+    }
+
+    void flush ()
+    {
+        std::size_t written = 0;
+
+        while (written < _out.size()) {
+            auto n = write(STDOUT_FILENO, _out.data() + written, _out.size() - written);
+
+            if (n < 0) {
+                if (errno == EINTR)
+                    continue;
+
+                // E.g. closed pipe
+                g_terminate = 1;
+                return;
+            }
+
+            written += static_cast<std::size_t>(n);
+        }
+    }
+
+private:
+    pfs::acpi _acpi;
+    std::uint32_t _fields;
+    format_enum _format;
+    int _devices;
+    std::vector<column> _columns;
+
+    // Reusable buffers
+    std::vector<std::int32_t> _values;
+    std::vector<int> _rates;
+    std::vector<float> _temperatures;
+    std::vector<int> _cur_states;
+    std::vector<int> _max_states;
+    std::vector<char> _out;
+};
+
+void print_usage (char const * program)
+{
+    fprintf(stderr, "Usage: %s [-i SECONDS] [-n COUNT] [-c CLASSES] [-f FIELDS]"
+        " [--csv | --json] [--overhead] [--sysfs-root DIR]\n"
+        "    CLASSES: bat, ac, tz, fan\n"
+        "    FIELDS : pct, sec, rate, state, online, temp, fan, fanmax\n", program);
+}
+
+} // namespace
+
+int main (int argc, char * argv[])
+{
+    double interval = 1.0;
+    long count = 0;
+    std::uint32_t classes_fields = 0;
+    std::uint32_t fields = 0;
+    format_enum format = format_text;
+    bool overhead = false;
+    std::string sysfs_root {"/sys"};
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-i") == 0 && i + 1 < argc) {
+            interval = atof(argv[++i]);
+        } else if (strcmp(argv[i], "-n") == 0 && i + 1 < argc) {
+            count = atol(argv[++i]);
+        } else if (strcmp(argv[i], "-c") == 0 && i + 1 < argc) {
+            auto ok = for_each_item(argv[++i], [& classes_fields] (std::string const & item) {
+                for (auto const & c: CLASSES) {
+                    if (item == c.name) {
+                        classes_fields |= monitor::fields_of(c.devices);
+                        return true;
+                    }
+                }
+
+                fprintf(stderr, "pfs-acpistat: unknown device class: %s\n", item.c_str());
+                return false;
+            });
+
+            if (!ok)
+                return EXIT_FAILURE;
+        } else if (strcmp(argv[i], "-f") == 0 && i + 1 < argc) {
+            auto ok = for_each_item(argv[++i], [& fields] (std::string const & item) {
+                for (auto const & f: FIELDS) {
+                    if (item == f.name) {
+                        fields |= monitor::field_bit(f.field);
+                        return true;
+                    }
+                }
+
+                fprintf(stderr, "pfs-acpistat: unknown field: %s\n", item.c_str());
+                return false;
+            });
+
+            if (!ok)
+                return EXIT_FAILURE;
+        } else if (strcmp(argv[i], "--csv") == 0) {
+            format = format_csv;
+        } else if (strcmp(argv[i], "--json") == 0) {
+            format = format_json;
+        } else if (strcmp(argv[i], "--overhead") == 0) {
+            overhead = true;
+        } else if (strcmp(argv[i], "--sysfs-root") == 0 && i + 1 < argc) {
+            sysfs_root = argv[++i];
+        } else {
+            print_usage(argv[0]);
+            return EXIT_FAILURE;
+        }
+    }
+
+    if (interval <= 0 || count < 0) {
+        print_usage(argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    if (fields == 0)
+        fields = classes_fields != 0 ? classes_fields : monitor::ALL_FIELDS;
+
+    struct sigaction sa;
+    std::memset(& sa, 0, sizeof(sa));
+    sa.sa_handler = on_signal;
+    sigaction(SIGINT, & sa, nullptr);
+    sigaction(SIGTERM, & sa, nullptr);
+    signal(SIGPIPE, SIG_IGN);
+
+    sampler s {sysfs_root, fields, format};
+
+    if (s.columns() == 0) {
+        fprintf(stderr, "pfs-acpistat: no devices with selected fields found\n");
+        return EXIT_FAILURE;
+    }
+
+    // Header is repeated when output goes to terminal, like vmstat does
+    int const header_period = format == format_text && isatty(STDOUT_FILENO) ? 20 : 0;
+
+    struct rusage usage_start;
+    getrusage(RUSAGE_SELF, & usage_start);
+    auto io_start = read_io_counters();
+    auto start = monotonic_seconds();
+
+    auto interval_ns = static_cast<long long>(interval * 1e9);
+    struct timespec deadline;
+    clock_gettime(CLOCK_MONOTONIC, & deadline);
+
+    long samples = 0;
+
+    s.print_header();
+
+    while (!g_terminate && (count == 0 || samples < count)) {
+        if (header_period > 0 && samples > 0 && samples % header_period == 0)
+            s.print_header();
+
+        s.sample(monotonic_seconds() - start);
+        ++samples;
+
+        if (count != 0 && samples == count)
+            break;
+
+        // Absolute deadlines keep the period stable regardless of sampling time
+        auto nsec = deadline.tv_nsec + interval_ns;
+        deadline.tv_sec += static_cast<time_t>(nsec / 1000000000LL);
+        deadline.tv_nsec = static_cast<long>(nsec % 1000000000LL);
+
+        while (!g_terminate && clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, & deadline, nullptr) == EINTR)
+            ;
+    }
+
+    if (overhead) {
+        auto elapsed = monotonic_seconds() - start;
+        auto io_end = read_io_counters();
+
+        struct rusage usage_end;
+        getrusage(RUSAGE_SELF, & usage_end);
+
+        auto user = cpu_seconds(usage_end.ru_utime) - cpu_seconds(usage_start.ru_utime);
+        auto sys = cpu_seconds(usage_end.ru_stime) - cpu_seconds(usage_start.ru_stime);
+        auto per_sample = samples > 0 ? static_cast<double>(samples) : 1.0;
+
+        fprintf(stderr, "pfs-acpistat: %ld samples in %.3f s\n", samples, elapsed);
+        fprintf(stderr, "  cpu time   : user %.3f ms, sys %.3f ms, %.1f us/sample, %.3f%% of wall time\n"
+            , user * 1e3, sys * 1e3, (user + sys) * 1e6 / per_sample
+            , elapsed > 0 ? (user + sys) * 100 / elapsed : 0.0);
+
+        if (io_start.syscr >= 0 && io_end.syscr >= 0) {
+            // Read of /proc/self/io at start is counted too
+            auto reads = io_end.syscr - io_start.syscr - 1;
+            auto writes = io_end.syscw - io_start.syscw;
+
+            fprintf(stderr, "  syscalls   : %lld reads (%.1f/sample), %lld writes (%.1f/sample)\n"
+                , reads, reads / per_sample, writes, writes / per_sample);
+        } else {
+            fprintf(stderr, "  syscalls   : unavailable (no /proc/self/io)\n");
+        }
+
+        fprintf(stderr, "  ctx switch : %ld voluntary, %ld involuntary\n"
+            , usage_end.ru_nvcsw - usage_start.ru_nvcsw
+            , usage_end.ru_nivcsw - usage_start.ru_nivcsw);
+    }
+
+    return EXIT_SUCCESS;
+}